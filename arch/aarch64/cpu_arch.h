@@ -0,0 +1,26 @@
+#define CPU_ASIMD   0x01
+#define CPU_CRC32   0x02
+#define CPU_ATOMICS 0x04
+#define CPU_PMULL   0x08
+#define CPU_SVE     0x10
+
+#define CPU_FEATURE_NAMES \
+	{ "asimd", CPU_ASIMD }, { "crc32", CPU_CRC32 }, \
+	{ "atomics", CPU_ATOMICS }, { "pmull", CPU_PMULL }, \
+	{ "sve", CPU_SVE }
+
+static inline unsigned long __cpu_probe(size_t hwcap)
+{
+	unsigned long f = 0;
+	if (hwcap & 1<<1) f |= CPU_ASIMD;
+	if (hwcap & 1<<7) f |= CPU_CRC32;
+	if (hwcap & 1<<8) f |= CPU_ATOMICS;
+	if (hwcap & 1<<4) f |= CPU_PMULL;
+	if (hwcap & 1<<22) f |= CPU_SVE;
+	return f;
+}
+
+static inline size_t __cpu_cache_size(void)
+{
+	return 0;
+}
@@ -9,3 +9,5 @@ static inline uintptr_t __get_tp()
 #define GAP_ABOVE_TP 16
 
 #define MC_PC pc
+
+#define RSEQ_SIG 0xd428bc00
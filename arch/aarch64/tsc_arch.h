@@ -0,0 +1,12 @@
+static inline uint64_t __tsc_read(void)
+{
+	uint64_t v;
+	__asm__ __volatile__ ("isb ; mrs %0, cntvct_el0" : "=r"(v) : : "memory");
+	return v;
+}
+
+/* The generic timer is architecturally constant-rate. */
+static inline int __tsc_usable(void)
+{
+	return 1;
+}
@@ -0,0 +1,11 @@
+#define CPU_FEATURE_NAMES { "", 0 }
+
+static inline unsigned long __cpu_probe(size_t hwcap)
+{
+	return 0;
+}
+
+static inline size_t __cpu_cache_size(void)
+{
+	return 0;
+}
@@ -0,0 +1,9 @@
+static inline uint64_t __tsc_read(void)
+{
+	return 0;
+}
+
+static inline int __tsc_usable(void)
+{
+	return 0;
+}
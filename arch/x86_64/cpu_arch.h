@@ -0,0 +1,77 @@
+#define CPU_SSE42   0x001
+#define CPU_POPCNT  0x002
+#define CPU_AVX     0x004
+#define CPU_AVX2    0x008
+#define CPU_FMA     0x010
+#define CPU_BMI2    0x020
+#define CPU_ERMS    0x040
+#define CPU_FSRM    0x080
+#define CPU_AVX512  0x100
+#define CPU_SSSE3   0x200
+
+#define CPU_FEATURE_NAMES \
+	{ "sse4.2", CPU_SSE42 }, { "popcnt", CPU_POPCNT }, \
+	{ "avx", CPU_AVX }, { "avx2", CPU_AVX2 }, { "fma", CPU_FMA }, \
+	{ "bmi2", CPU_BMI2 }, { "erms", CPU_ERMS }, { "fsrm", CPU_FSRM }, \
+	{ "avx512", CPU_AVX512 }, { "ssse3", CPU_SSSE3 }
+
+static inline void __cpuid(uint32_t leaf, uint32_t sub, uint32_t r[4])
+{
+	__asm__ ("cpuid" : "=a"(r[0]), "=b"(r[1]), "=c"(r[2]), "=d"(r[3])
+		: "a"(leaf), "c"(sub));
+}
+
+/* Vector features are only reported when the kernel saves the
+ * corresponding register state (XCR0). CPU_AVX512 requires the F,
+ * BW and VL subsets together. */
+static inline unsigned long __cpu_probe(size_t hwcap)
+{
+	uint32_t r[4], max, xcr0 = 0, d;
+	unsigned long f = 0;
+
+	__cpuid(0, 0, r);
+	max = r[0];
+	__cpuid(1, 0, r);
+	if (r[2] & 1<<9) f |= CPU_SSSE3;
+	if (r[2] & 1<<20) f |= CPU_SSE42;
+	if (r[2] & 1<<23) f |= CPU_POPCNT;
+	if (r[2] & 1<<27)
+		__asm__ ("xgetbv" : "=a"(xcr0), "=d"(d) : "c"(0));
+	if ((xcr0 & 6) == 6) {
+		if (r[2] & 1<<28) f |= CPU_AVX;
+		if (r[2] & 1<<12 && f & CPU_AVX) f |= CPU_FMA;
+	}
+	if (max >= 7) {
+		__cpuid(7, 0, r);
+		if (r[1] & 1<<5 && f & CPU_AVX) f |= CPU_AVX2;
+		if (r[1] & 1<<8) f |= CPU_BMI2;
+		if (r[1] & 1<<9) f |= CPU_ERMS;
+		if (r[3] & 1<<4) f |= CPU_FSRM;
+		if ((xcr0 & 0xe6) == 0xe6 && (~r[1] & 0xc0010000) == 0)
+			f |= CPU_AVX512;
+	}
+	return f;
+}
+
+/* Size of the outermost cache, from the deterministic cache leaf
+ * (Intel, recent AMD) or the legacy extended leaf, or 0 if unknown. */
+static inline size_t __cpu_cache_size(void)
+{
+	uint32_t r[4], i;
+	size_t sz = 0;
+
+	__cpuid(0, 0, r);
+	if (r[0] >= 4) for (i=0; i<16; i++) {
+		__cpuid(4, i, r);
+		if (!(r[0] & 31)) break;
+		if ((r[0] & 31) == 2) continue;
+		sz = (size_t)((r[1]>>22)+1) * (((r[1]>>12)&1023)+1)
+			* ((r[1]&4095)+1) * (r[2]+1);
+	}
+	if (sz) return sz;
+	__cpuid(0x80000000, 0, r);
+	if (r[0] < 0x80000006) return 0;
+	__cpuid(0x80000006, 0, r);
+	if (r[3]>>18) return (size_t)(r[3]>>18) << 19;
+	return (size_t)(r[2]>>16) << 10;
+}
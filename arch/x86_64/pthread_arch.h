@@ -6,3 +6,5 @@ static inline uintptr_t __get_tp()
 }
 
 #define MC_PC gregs[REG_RIP]
+
+#define RSEQ_SIG 0x53053053
@@ -0,0 +1,17 @@
+static inline uint64_t __tsc_read(void)
+{
+	uint32_t lo, hi;
+	__asm__ __volatile__ ("rdtsc" : "=a"(lo), "=d"(hi));
+	return (uint64_t)hi<<32 | lo;
+}
+
+/* Only an invariant TSC ticks at a constant rate in all power
+ * states and is usable as a clock. */
+static inline int __tsc_usable(void)
+{
+	uint32_t a, b, c, d;
+	__asm__ ("cpuid" : "=a"(a), "=b"(b), "=c"(c), "=d"(d) : "a"(0x80000000), "c"(0));
+	if (a < 0x80000007) return 0;
+	__asm__ ("cpuid" : "=a"(a), "=b"(b), "=c"(c), "=d"(d) : "a"(0x80000007), "c"(0));
+	return d >> 8 & 1;
+}
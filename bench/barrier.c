@@ -0,0 +1,76 @@
+/* Compare the central and combining-tree pthread_barrier_wait.
+ *
+ * usage: barrier [rounds] [threads...]
+ *
+ * For every thread count, each kind is timed over the given number of
+ * rounds, after a warmup, and the per-episode cost is reported. */
+
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+static pthread_barrier_t bar;
+static int rounds;
+
+static long long now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static void *worker(void *arg)
+{
+	for (int i = 0; i < rounds; i++)
+		pthread_barrier_wait(&bar);
+	return 0;
+}
+
+static double run(int kind, int n)
+{
+	pthread_barrierattr_t a;
+	pthread_t *t = malloc(n * sizeof *t);
+	long long t0;
+
+	pthread_barrierattr_init(&a);
+	pthread_barrierattr_setkind_np(&a, kind);
+	if (!t || pthread_barrier_init(&bar, &a, n)) {
+		fprintf(stderr, "barrier init failed for %d threads\n", n);
+		exit(1);
+	}
+	for (int i = 1; i < n; i++)
+		if (pthread_create(&t[i], 0, worker, 0)) {
+			fprintf(stderr, "pthread_create failed\n");
+			exit(1);
+		}
+	for (int i = 0; i < rounds/10; i++)
+		pthread_barrier_wait(&bar);
+	t0 = now();
+	for (int i = rounds/10; i < rounds; i++)
+		pthread_barrier_wait(&bar);
+	t0 = now() - t0;
+	for (int i = 1; i < n; i++)
+		pthread_join(t[i], 0);
+	pthread_barrier_destroy(&bar);
+	free(t);
+	return (double)t0 / (rounds - rounds/10);
+}
+
+int main(int argc, char **argv)
+{
+	static const int def[] = { 2, 4, 8, 16, 32, 64, 128 };
+	int i, n;
+
+	rounds = argc > 1 ? atoi(argv[1]) : 2000;
+	if (rounds < 10) rounds = 10;
+	printf("%8s %14s %14s\n", "threads", "central ns/ep", "tree ns/ep");
+	for (i = 0; argc > 2 ? i < argc-2 : i < (int)(sizeof def/sizeof *def); i++) {
+		n = argc > 2 ? atoi(argv[i+2]) : def[i];
+		if (n < 2) continue;
+		printf("%8d %14.0f", n, run(PTHREAD_BARRIER_CENTRAL_NP, n));
+		printf(" %14.0f\n", run(PTHREAD_BARRIER_TREE_NP, n));
+	}
+	return 0;
+}
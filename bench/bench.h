@@ -0,0 +1,27 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stddef.h>
+
+/* A benchmark body runs its operation n times on arg. bench() times
+ * it and prints one result line; bytes, if nonzero, is the amount of
+ * data one operation handles and adds a throughput column. */
+
+typedef void (*bench_fn)(void *, long);
+
+void bench(const char *, bench_fn, void *, size_t);
+int bench_selected(const char *);
+unsigned bench_rand(void);
+
+/* keep the compiler from discarding or hoisting work on x */
+#define CLOBBER(x) __asm__ __volatile__ ("" : : "g"(x) : "memory")
+
+void bench_string(void);
+void bench_stdio(void);
+void bench_fmt(void);
+void bench_sort(void);
+void bench_thread(void);
+void bench_malloc(void);
+void bench_time(void);
+
+#endif
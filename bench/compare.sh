@@ -0,0 +1,16 @@
+#!/bin/sh
+# Compare two libcbench outputs by median time.
+#
+# usage: compare.sh old.txt new.txt
+#
+# Prints each benchmark present in both, with the old and new medians
+# and new/old; values below 1 are speedups.
+
+[ $# -eq 2 ] || { echo "usage: $0 old new" >&2; exit 1; }
+
+awk '
+/^#/ { next }
+NR == FNR { old[$1] = $2; next }
+$1 in old && old[$1] > 0 {
+	printf "%-40s %12.2f %12.2f %8.3f\n", $1, old[$1], $2, $2 / old[$1]
+}' "$1" "$2"
@@ -0,0 +1,90 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench.h"
+
+static FILE *null_f;
+
+#define SNPRINTF(f, ...) \
+static void f(void *p, long n) \
+{ \
+	char buf[128]; \
+	while (n--) { snprintf(buf, sizeof buf, __VA_ARGS__); CLOBBER(buf); } \
+}
+
+SNPRINTF(b_snprintf_d, "%d", (int)n)
+SNPRINTF(b_snprintf_x, "%08lx", (unsigned long)n)
+SNPRINTF(b_snprintf_s, "%s=%s", "Content-Type", "text/plain")
+SNPRINTF(b_snprintf_mixed, "%5d %-8s %08x %ld", (int)n, "name", (unsigned)n, (long)n * 1000003)
+SNPRINTF(b_snprintf_f, "%f", n * 1.0625)
+SNPRINTF(b_snprintf_g17, "%.17g", n * 0.1)
+SNPRINTF(b_snprintf_e, "%e", n * 1e-300)
+SNPRINTF(b_snprintf_Lf, "%Lf", n * 1.0625L)
+
+static void b_fprintf(void *p, long n)
+{
+	while (n--) fprintf(null_f, "%s: %d %g\n", "line", (int)n, n * 0.5);
+}
+
+static const char *const fp_inputs[] = {
+	"0", "1", "3.14159", "0.1", "1e300", "2.2250738585072014e-308",
+	"123456789012345678901234567890e-10", "0x1.fffffffffffffp+1023",
+	"4.9406564584124654e-324", "nan", "inf",
+};
+
+static void b_strtod(void *p, long n)
+{
+	const char *s = *(const char **)p;
+	while (n--) CLOBBER(strtod(s, 0));
+}
+
+static void b_strtof(void *p, long n)
+{
+	const char *s = *(const char **)p;
+	while (n--) CLOBBER(strtof(s, 0));
+}
+
+static void b_strtol(void *p, long n)
+{
+	const char *s = *(const char **)p;
+	while (n--) CLOBBER(strtol(s, 0, 0));
+}
+
+static void b_atoi(void *p, long n)
+{
+	const char *s = *(const char **)p;
+	while (n--) CLOBBER(atoi(s));
+}
+
+void bench_fmt(void)
+{
+	static const char *const ints[] = { "7", "-123456", "0x7fffffff", "9223372036854775807" };
+	char name[80];
+	size_t i;
+
+	null_f = fopen("/dev/null", "w");
+	if (!null_f) {
+		perror("/dev/null");
+		exit(1);
+	}
+	bench("snprintf/%d", b_snprintf_d, 0, 0);
+	bench("snprintf/%08lx", b_snprintf_x, 0, 0);
+	bench("snprintf/%s=%s", b_snprintf_s, 0, 0);
+	bench("snprintf/mixed", b_snprintf_mixed, 0, 0);
+	bench("snprintf/%f", b_snprintf_f, 0, 0);
+	bench("snprintf/%.17g", b_snprintf_g17, 0, 0);
+	bench("snprintf/%e", b_snprintf_e, 0, 0);
+	bench("snprintf/%Lf", b_snprintf_Lf, 0, 0);
+	bench("fprintf", b_fprintf, 0, 0);
+
+	for (i = 0; i < sizeof fp_inputs / sizeof *fp_inputs; i++) {
+		snprintf(name, sizeof name, "strtod/%s", fp_inputs[i]);
+		bench(name, b_strtod, (void *)&fp_inputs[i], 0);
+	}
+	bench("strtof/3.14159", b_strtof, (void *)&fp_inputs[2], 0);
+	for (i = 0; i < sizeof ints / sizeof *ints; i++) {
+		snprintf(name, sizeof name, "strtol/%s", ints[i]);
+		bench(name, b_strtol, (void *)&ints[i], 0);
+	}
+	bench("atoi/-123456", b_atoi, (void *)&ints[1], 0);
+	fclose(null_f);
+}
@@ -0,0 +1,155 @@
+/* libc microbenchmarks.
+ *
+ * usage: libcbench [-q] [-c cpu] [-n samples] [-t ms] [pattern...]
+ *
+ * Only benchmarks whose name contains one of the patterns are run.
+ * The process is pinned to one cpu, each benchmark is calibrated so
+ * one sample takes about -t milliseconds, a warmup sample is thrown
+ * away, and the median and 10th/90th percentiles of the per-operation
+ * time over -n samples are printed. Inputs come from a fixed-seed
+ * generator, so the output of two builds lines up for comparison with
+ * bench/compare.sh. */
+
+#define _GNU_SOURCE
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "bench.h"
+
+#define MAX_SAMPLES 101
+
+static int samples = 11;
+static long sample_ns = 2000000;
+static char **patterns;
+static int npatterns;
+static uint64_t seed = 1;
+
+unsigned bench_rand(void)
+{
+	seed = 6364136223846793005ULL * seed + 1;
+	return seed >> 33;
+}
+
+static long long now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static int cmpd(const void *a, const void *b)
+{
+	double x = *(const double *)a, y = *(const double *)b;
+	return (x > y) - (x < y);
+}
+
+int bench_selected(const char *name)
+{
+	int i;
+	if (!npatterns) return 1;
+	for (i = 0; i < npatterns; i++)
+		if (strstr(name, patterns[i])) return 1;
+	return 0;
+}
+
+void bench(const char *name, bench_fn fn, void *arg, size_t bytes)
+{
+	double t[MAX_SAMPLES], med;
+	long long t0, dt;
+	long n;
+	int i;
+
+	if (!bench_selected(name)) return;
+
+	/* calibrate, which also warms caches and predictors */
+	for (n = 1; ; n *= 2) {
+		t0 = now();
+		fn(arg, n);
+		dt = now() - t0;
+		if (dt >= sample_ns/8 || n >= 1L<<40) break;
+	}
+	if (dt <= 0) dt = 1;
+	n = (double)n * sample_ns / dt;
+	if (n < 1) n = 1;
+
+	fn(arg, n);
+	for (i = 0; i < samples; i++) {
+		t0 = now();
+		fn(arg, n);
+		t[i] = (double)(now() - t0) / n;
+	}
+	qsort(t, samples, sizeof *t, cmpd);
+	med = t[samples/2];
+	printf("%-40s %12.2f %12.2f %12.2f", name, med,
+		t[(samples-1)/10], t[samples-1 - (samples-1)/10]);
+	if (bytes) printf(" %10.1f", bytes / med * 1e3);
+	putchar('\n');
+	fflush(stdout);
+}
+
+static int pin(int cpu)
+{
+	cpu_set_t set;
+	int i;
+
+	if (cpu < 0) {
+		if (sched_getaffinity(0, sizeof set, &set)) return -1;
+		for (i = 0; i < CPU_SETSIZE && !CPU_ISSET(i, &set); i++);
+		if (i == CPU_SETSIZE) return -1;
+		cpu = i;
+	}
+	CPU_ZERO(&set);
+	CPU_SET(cpu, &set);
+	if (sched_setaffinity(0, sizeof set, &set)) return -1;
+	return cpu;
+}
+
+static void (*const suites[])(void) = {
+	bench_string, bench_stdio, bench_fmt, bench_sort,
+	bench_thread, bench_malloc, bench_time,
+};
+
+int main(int argc, char **argv)
+{
+	int c, cpu = -1;
+	size_t i;
+
+	while ((c = getopt(argc, argv, "qc:n:t:")) != -1) switch (c) {
+	case 'q':
+		samples = 5;
+		sample_ns = 500000;
+		break;
+	case 'c':
+		cpu = atoi(optarg);
+		break;
+	case 'n':
+		samples = atoi(optarg);
+		if (samples < 1) samples = 1;
+		if (samples > MAX_SAMPLES) samples = MAX_SAMPLES;
+		break;
+	case 't':
+		sample_ns = atof(optarg) * 1e6;
+		if (sample_ns < 1000) sample_ns = 1000;
+		break;
+	default:
+		fprintf(stderr, "usage: %s [-q] [-c cpu] [-n samples] [-t ms] [pattern...]\n", argv[0]);
+		return 1;
+	}
+	patterns = argv + optind;
+	npatterns = argc - optind;
+
+	cpu = pin(cpu);
+	if (cpu < 0) perror("sched_setaffinity");
+	printf("# cpu %d, %d samples of %.1f ms\n", cpu, samples, sample_ns / 1e6);
+	printf("%-40s %12s %12s %12s %10s\n", "# name", "median ns", "p10 ns", "p90 ns", "MB/s");
+
+	for (i = 0; i < sizeof suites / sizeof *suites; i++) {
+		seed = 1;
+		suites[i]();
+	}
+	return 0;
+}
@@ -0,0 +1,92 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+
+#define BATCH 1024
+
+static void b_malloc_free(void *p, long n)
+{
+	size_t sz = *(size_t *)p;
+	while (n--) {
+		void *q = malloc(sz);
+		CLOBBER(q);
+		free(q);
+	}
+}
+
+static void b_calloc_free(void *p, long n)
+{
+	size_t sz = *(size_t *)p;
+	while (n--) {
+		void *q = calloc(1, sz);
+		CLOBBER(q);
+		free(q);
+	}
+}
+
+static void b_realloc_grow(void *p, long n)
+{
+	size_t sz;
+	while (n--) {
+		void *q = 0;
+		for (sz = 16; sz <= 65536; sz *= 2) q = realloc(q, sz);
+		free(q);
+	}
+}
+
+/* one operation allocates a batch of mixed sizes and frees it in a
+ * shuffled order */
+static size_t batch_sz[BATCH], batch_order[BATCH];
+static void *batch[BATCH];
+
+static void b_batch(void *p, long n)
+{
+	size_t i;
+	while (n--) {
+		for (i = 0; i < BATCH; i++) batch[i] = malloc(batch_sz[i]);
+		for (i = 0; i < BATCH; i++) free(batch[batch_order[i]]);
+	}
+}
+
+/* a steady-state heap: free a random slot and refill it */
+static void b_churn(void *p, long n)
+{
+	size_t i;
+	while (n--) {
+		i = bench_rand() % BATCH;
+		free(batch[i]);
+		batch[i] = malloc(batch_sz[(i + n) % BATCH]);
+	}
+}
+
+void bench_malloc(void)
+{
+	static const size_t sizes[] = { 16, 64, 256, 1024, 4096, 65536, 1<<20 };
+	char name[64];
+	size_t i, j, t;
+
+	for (i = 0; i < sizeof sizes / sizeof *sizes; i++) {
+		snprintf(name, sizeof name, "malloc_free/%zu", sizes[i]);
+		bench(name, b_malloc_free, (void *)&sizes[i], 0);
+	}
+	for (i = 0; i < sizeof sizes / sizeof *sizes; i++) {
+		snprintf(name, sizeof name, "calloc_free/%zu", sizes[i]);
+		bench(name, b_calloc_free, (void *)&sizes[i], 0);
+	}
+	bench("realloc/16-65536", b_realloc_grow, 0, 0);
+
+	for (i = 0; i < BATCH; i++) {
+		batch_sz[i] = 16 + bench_rand() % 1009;
+		batch_order[i] = i;
+	}
+	for (i = BATCH-1; i > 0; i--) {
+		j = bench_rand() % (i+1);
+		t = batch_order[i], batch_order[i] = batch_order[j], batch_order[j] = t;
+	}
+	bench("batch/1024x16-1024", b_batch, 0, 0);
+
+	for (i = 0; i < BATCH; i++) batch[i] = malloc(batch_sz[i]);
+	bench("churn/1024x16-1024", b_churn, 0, 0);
+	for (i = 0; i < BATCH; i++) free(batch[i]);
+}
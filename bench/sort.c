@@ -0,0 +1,136 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+
+struct sort {
+	int *in, *work;
+	size_t n;
+};
+
+struct rec {
+	long key;
+	char pad[56];
+};
+
+static int cmp_int(const void *a, const void *b)
+{
+	int x = *(const int *)a, y = *(const int *)b;
+	return (x > y) - (x < y);
+}
+
+static int cmp_rec(const void *a, const void *b)
+{
+	long x = ((const struct rec *)a)->key, y = ((const struct rec *)b)->key;
+	return (x > y) - (x < y);
+}
+
+static int cmp_str(const void *a, const void *b)
+{
+	return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+/* each operation sorts a fresh copy of the input */
+static void b_qsort(void *p, long n)
+{
+	struct sort *s = p;
+	while (n--) {
+		memcpy(s->work, s->in, s->n * sizeof *s->in);
+		qsort(s->work, s->n, sizeof *s->work, cmp_int);
+	}
+}
+
+static struct rec *recs, *recs_work;
+static size_t nrecs;
+
+static void b_qsort_rec(void *p, long n)
+{
+	while (n--) {
+		memcpy(recs_work, recs, nrecs * sizeof *recs);
+		qsort(recs_work, nrecs, sizeof *recs_work, cmp_rec);
+	}
+}
+
+static char **strs, **strs_work;
+static size_t nstrs;
+
+static void b_qsort_str(void *p, long n)
+{
+	while (n--) {
+		memcpy(strs_work, strs, nstrs * sizeof *strs);
+		qsort(strs_work, nstrs, sizeof *strs_work, cmp_str);
+	}
+}
+
+static void b_bsearch(void *p, long n)
+{
+	struct sort *s = p;
+	int key;
+	while (n--) {
+		key = s->in[n % s->n];
+		CLOBBER(bsearch(&key, s->work, s->n, sizeof *s->work, cmp_int));
+	}
+}
+
+void bench_sort(void)
+{
+	static const size_t sizes[] = { 16, 1024, 65536 };
+	static const char *const kinds[] = { "random", "sorted", "reversed", "few" };
+	struct sort s;
+	char name[64], *pool;
+	size_t i, j, k, max = sizes[sizeof sizes / sizeof *sizes - 1];
+
+	s.in = malloc(max * sizeof *s.in);
+	s.work = malloc(max * sizeof *s.work);
+	if (!s.in || !s.work) {
+		perror("malloc");
+		exit(1);
+	}
+	for (i = 0; i < sizeof sizes / sizeof *sizes; i++) {
+		s.n = sizes[i];
+		for (k = 0; k < sizeof kinds / sizeof *kinds; k++) {
+			snprintf(name, sizeof name, "qsort/int/%s/%zu", kinds[k], s.n);
+			for (j = 0; j < s.n; j++) switch (k) {
+			case 0: s.in[j] = bench_rand(); break;
+			case 1: s.in[j] = j; break;
+			case 2: s.in[j] = s.n - j; break;
+			case 3: s.in[j] = bench_rand() % 8; break;
+			}
+			bench(name, b_qsort, &s, 0);
+		}
+	}
+
+	s.n = 1024;
+	for (j = 0; j < s.n; j++) s.in[j] = bench_rand();
+	memcpy(s.work, s.in, s.n * sizeof *s.in);
+	qsort(s.work, s.n, sizeof *s.work, cmp_int);
+	bench("bsearch/int/1024", b_bsearch, &s, 0);
+
+	nrecs = 4096;
+	recs = calloc(nrecs, sizeof *recs);
+	recs_work = malloc(nrecs * sizeof *recs);
+	nstrs = 4096;
+	strs = malloc(nstrs * sizeof *strs);
+	strs_work = malloc(nstrs * sizeof *strs);
+	pool = malloc(nstrs * 16);
+	if (!recs || !recs_work || !strs || !strs_work || !pool) {
+		perror("malloc");
+		exit(1);
+	}
+	for (j = 0; j < nrecs; j++) recs[j].key = bench_rand();
+	bench("qsort/rec64/random/4096", b_qsort_rec, 0, 0);
+	for (j = 0; j < nstrs; j++) {
+		strs[j] = pool + 16*j;
+		for (k = 0; k < 15; k++) strs[j][k] = k < 8 ? 'p' : 'a' + bench_rand() % 26;
+		strs[j][15] = 0;
+	}
+	bench("qsort/str/random/4096", b_qsort_str, 0, 0);
+
+	free(pool);
+	free(strs_work);
+	free(strs);
+	free(recs_work);
+	free(recs);
+	free(s.work);
+	free(s.in);
+}
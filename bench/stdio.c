@@ -0,0 +1,105 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+
+#define FILE_SIZE (1<<20)
+#define LINE 80
+
+static FILE *null_f, *data_f;
+static char block[65536];
+
+static void b_fwrite(void *p, long n)
+{
+	size_t sz = *(size_t *)p;
+	while (n--) fwrite(block, 1, sz, null_f);
+}
+
+static void b_fputc(void *p, long n)
+{
+	while (n--) fputc('x', null_f);
+}
+
+static void b_putc_unlocked(void *p, long n)
+{
+	while (n--) putc_unlocked('x', null_f);
+}
+
+static void b_fputs(void *p, long n)
+{
+	while (n--) fputs("a line of text of moderate length\n", null_f);
+}
+
+static void b_fread(void *p, long n)
+{
+	size_t sz = *(size_t *)p;
+	while (n--) if (fread(block, 1, sz, data_f) < sz) rewind(data_f);
+}
+
+static void b_fgetc(void *p, long n)
+{
+	while (n--) if (fgetc(data_f) == EOF) rewind(data_f);
+}
+
+static void b_getc_unlocked(void *p, long n)
+{
+	while (n--) if (getc_unlocked(data_f) == EOF) rewind(data_f);
+}
+
+static void b_fgets(void *p, long n)
+{
+	char line[LINE*2];
+	while (n--) if (!fgets(line, sizeof line, data_f)) rewind(data_f);
+}
+
+static void b_getline(void *p, long n)
+{
+	static char *line;
+	static size_t len;
+	while (n--) if (getline(&line, &len, data_f) < 0) rewind(data_f);
+}
+
+void bench_stdio(void)
+{
+	static const size_t sizes[] = { 16, 256, 4096, 65536 };
+	char name[64], *buf;
+	size_t i;
+
+	null_f = fopen("/dev/null", "w");
+	data_f = tmpfile();
+	buf = malloc(FILE_SIZE);
+	if (!null_f || !data_f || !buf) {
+		perror("stdio setup");
+		exit(1);
+	}
+	for (i = 0; i < FILE_SIZE; i++)
+		buf[i] = i % LINE == LINE-1 ? '\n' : 'a' + bench_rand() % 26;
+	if (fwrite(buf, 1, FILE_SIZE, data_f) != FILE_SIZE) {
+		perror("tmpfile");
+		exit(1);
+	}
+	free(buf);
+	memset(block, 'x', sizeof block);
+
+	for (i = 0; i < sizeof sizes / sizeof *sizes; i++) {
+		snprintf(name, sizeof name, "fwrite/%zu", sizes[i]);
+		bench(name, b_fwrite, (void *)&sizes[i], sizes[i]);
+	}
+	bench("fputc", b_fputc, 0, 1);
+	bench("putc_unlocked", b_putc_unlocked, 0, 1);
+	bench("fputs", b_fputs, 0, 34);
+
+	rewind(data_f);
+	for (i = 0; i < sizeof sizes / sizeof *sizes; i++) {
+		snprintf(name, sizeof name, "fread/%zu", sizes[i]);
+		bench(name, b_fread, (void *)&sizes[i], sizes[i]);
+	}
+	bench("fgetc", b_fgetc, 0, 1);
+	bench("getc_unlocked", b_getc_unlocked, 0, 1);
+	bench("fgets/80", b_fgets, 0, LINE);
+	bench("getline/80", b_getline, 0, LINE);
+
+	fclose(null_f);
+	fclose(data_f);
+}
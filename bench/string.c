@@ -0,0 +1,128 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include "bench.h"
+
+struct buf {
+	char *s, *d;
+	size_t n;
+	char *needle;
+};
+
+#define BODY(f, expr) \
+static void f(void *p, long n) \
+{ \
+	struct buf *b = p; \
+	while (n--) { expr; CLOBBER(b->d); } \
+}
+
+BODY(b_memcpy, CLOBBER(memcpy(b->d, b->s, b->n)))
+BODY(b_memmove, CLOBBER(memmove(b->d, b->s, b->n)))
+BODY(b_memset, CLOBBER(memset(b->d, n, b->n)))
+BODY(b_memcmp, CLOBBER(memcmp(b->d, b->s, b->n)))
+BODY(b_memchr, CLOBBER(memchr(b->s, '\n', b->n)))
+BODY(b_strlen, CLOBBER(strlen(b->s)))
+BODY(b_strchr, CLOBBER(strchr(b->s, '\n')))
+BODY(b_strrchr, CLOBBER(strrchr(b->s, 'a')))
+BODY(b_strcmp, CLOBBER(strcmp(b->d, b->s)))
+BODY(b_strcpy, CLOBBER(strcpy(b->d, b->s)))
+BODY(b_strcasecmp, CLOBBER(strcasecmp(b->d, b->s)))
+BODY(b_strspn, CLOBBER(strspn(b->s, "abcdefghijklmnopqrstuvwxyz")))
+BODY(b_strcspn, CLOBBER(strcspn(b->s, "\n\r:")))
+BODY(b_strstr, CLOBBER(strstr(b->s, b->needle)))
+BODY(b_memmem, CLOBBER(memmem(b->s, b->n, b->needle, strlen(b->needle))))
+BODY(b_strcasestr, CLOBBER(strcasestr(b->s, b->needle)))
+
+static const struct {
+	const char *name;
+	bench_fn fn;
+	int two;
+} ops[] = {
+	{ "memcpy", b_memcpy, 1 },
+	{ "memmove", b_memmove, 1 },
+	{ "memset", b_memset, 1 },
+	{ "memcmp", b_memcmp, 1 },
+	{ "memchr", b_memchr, 0 },
+	{ "strlen", b_strlen, 0 },
+	{ "strchr", b_strchr, 0 },
+	{ "strrchr", b_strrchr, 0 },
+	{ "strcmp", b_strcmp, 1 },
+	{ "strcpy", b_strcpy, 1 },
+	{ "strcasecmp", b_strcasecmp, 1 },
+	{ "strspn", b_strspn, 0 },
+	{ "strcspn", b_strcspn, 0 },
+	{ "strstr", b_strstr, 0 },
+	{ "memmem", b_memmem, 0 },
+	{ "strcasestr", b_strcasestr, 0 },
+};
+
+static const size_t sizes[] = { 8, 16, 32, 64, 128, 256, 1024, 4096, 16384, 65536, 1<<20 };
+
+/* source/destination misalignments tried at a few sizes */
+static const struct { int s, d; } aligns[] = { { 1, 0 }, { 0, 3 }, { 7, 13 } };
+static const size_t align_sizes[] = { 64, 4096 };
+
+#define MAXN (1<<20)
+#define PAD 64
+
+static char *src, *dst;
+
+static void fill(char *s, size_t n, int upper)
+{
+	size_t i;
+	for (i = 0; i < n; i++) {
+		s[i] = 'a' + bench_rand() % 26;
+		if (upper && i % 3 == 0) s[i] -= 32;
+	}
+}
+
+static void run(int k, size_t n, int sa, int da)
+{
+	char name[64], needle[16];
+	struct buf b = { src + sa, dst + da, n, needle };
+	size_t i;
+
+	if (sa || da) snprintf(name, sizeof name, "%s/%zu/%d:%d", ops[k].name, n, sa, da);
+	else snprintf(name, sizeof name, "%s/%zu", ops[k].name, n);
+	if (!bench_selected(name)) return;
+
+	/* strings of n bytes without '\n' or a late 'a', ending in nul;
+	 * needles occur only at the very end */
+	fill(b.s, n, 0);
+	for (i = 0; i < n; i++) if (b.s[i] == 'a') b.s[i] = 'b';
+	if (n > 1) b.s[n-2] = 'a';
+	b.s[n] = 0;
+	fill(needle, sizeof needle - 1, 0);
+	needle[sizeof needle - 1] = 0;
+	if (n >= sizeof needle) memcpy(b.s + n - sizeof needle, needle, sizeof needle - 1);
+	if (!strcmp(ops[k].name, "strcasecmp")) {
+		for (i = 0; i < n; i++) b.d[i] = b.s[i] ^ (i%3 ? 0 : 32);
+		b.d[n] = 0;
+	} else memcpy(b.d, b.s, n+1);
+
+	bench(name, ops[k].fn, &b, n);
+}
+
+void bench_string(void)
+{
+	size_t i, j, k;
+
+	src = malloc(MAXN + PAD);
+	dst = malloc(MAXN + PAD);
+	if (!src || !dst) {
+		perror("malloc");
+		exit(1);
+	}
+	for (k = 0; k < sizeof ops / sizeof *ops; k++) {
+		for (i = 0; i < sizeof sizes / sizeof *sizes; i++)
+			run(k, sizes[i], 0, 0);
+		for (i = 0; i < sizeof align_sizes / sizeof *align_sizes; i++)
+			for (j = 0; j < sizeof aligns / sizeof *aligns; j++)
+				if (ops[k].two || aligns[j].s)
+					run(k, align_sizes[i], aligns[j].s, aligns[j].d);
+	}
+	free(src);
+	free(dst);
+}
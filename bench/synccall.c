@@ -0,0 +1,80 @@
+/* Latency of a process-wide credential or limit change, which runs
+ * through __synccall, against the number of threads.
+ *
+ * usage: synccall [rounds] [threads...]
+ *
+ * Idle threads are parked in a blocking read on a pipe; the main
+ * thread then times setgid to its current group id, which must be
+ * applied in every thread. */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+static int pfd[2];
+
+static long long now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static void *idle(void *arg)
+{
+	char c;
+	read(pfd[0], &c, 1);
+	return 0;
+}
+
+static double run(int n, int rounds)
+{
+	pthread_attr_t a;
+	pthread_t *t = malloc(n * sizeof *t);
+	long long t0;
+	int i;
+
+	pthread_attr_init(&a);
+	pthread_attr_setstacksize(&a, 16384);
+	if (!t || pipe(pfd)) {
+		fprintf(stderr, "setup failed\n");
+		exit(1);
+	}
+	for (i = 0; i < n; i++)
+		if (pthread_create(&t[i], &a, idle, 0)) {
+			fprintf(stderr, "pthread_create failed at %d threads\n", i);
+			exit(1);
+		}
+	setgid(getgid());
+	t0 = now();
+	for (i = 0; i < rounds; i++)
+		if (setgid(getgid())) {
+			perror("setgid");
+			exit(1);
+		}
+	t0 = now() - t0;
+	close(pfd[1]);
+	for (i = 0; i < n; i++)
+		pthread_join(t[i], 0);
+	close(pfd[0]);
+	free(t);
+	return (double)t0 / rounds;
+}
+
+int main(int argc, char **argv)
+{
+	static const int def[] = { 1, 4, 16, 64, 256, 1024 };
+	int i, n, rounds;
+
+	rounds = argc > 1 ? atoi(argv[1]) : 50;
+	if (rounds < 1) rounds = 1;
+	printf("%8s %14s\n", "threads", "us/call");
+	for (i = 0; argc > 2 ? i < argc-2 : i < (int)(sizeof def/sizeof *def); i++) {
+		n = argc > 2 ? atoi(argv[i+2]) : def[i];
+		if (n < 0) continue;
+		printf("%8d %14.1f\n", n, run(n, rounds) / 1000);
+	}
+	return 0;
+}
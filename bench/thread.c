@@ -0,0 +1,205 @@
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench.h"
+
+static void b_mutex(void *p, long n)
+{
+	pthread_mutex_t *m = p;
+	while (n--) {
+		pthread_mutex_lock(m);
+		pthread_mutex_unlock(m);
+	}
+}
+
+static void b_trylock(void *p, long n)
+{
+	pthread_mutex_t *m = p;
+	while (n--) if (!pthread_mutex_trylock(m)) pthread_mutex_unlock(m);
+}
+
+static void b_spin(void *p, long n)
+{
+	pthread_spinlock_t *s = p;
+	while (n--) {
+		pthread_spin_lock(s);
+		pthread_spin_unlock(s);
+	}
+}
+
+static void b_rdlock(void *p, long n)
+{
+	pthread_rwlock_t *l = p;
+	while (n--) {
+		pthread_rwlock_rdlock(l);
+		pthread_rwlock_unlock(l);
+	}
+}
+
+static void b_wrlock(void *p, long n)
+{
+	pthread_rwlock_t *l = p;
+	while (n--) {
+		pthread_rwlock_wrlock(l);
+		pthread_rwlock_unlock(l);
+	}
+}
+
+static void b_cond_signal(void *p, long n)
+{
+	pthread_cond_t *c = p;
+	while (n--) pthread_cond_signal(c);
+}
+
+static void b_sem(void *p, long n)
+{
+	sem_t *s = p;
+	while (n--) {
+		sem_post(s);
+		sem_wait(s);
+	}
+}
+
+static void init_once(void)
+{
+}
+
+static void b_once(void *p, long n)
+{
+	pthread_once_t *o = p;
+	while (n--) pthread_once(o, init_once);
+}
+
+static void b_getspecific(void *p, long n)
+{
+	pthread_key_t *k = p;
+	while (n--) CLOBBER(pthread_getspecific(*k));
+}
+
+static void b_setspecific(void *p, long n)
+{
+	pthread_key_t *k = p;
+	while (n--) pthread_setspecific(*k, &n);
+}
+
+static void b_self(void *p, long n)
+{
+	while (n--) CLOBBER(pthread_self());
+}
+
+static void *nop(void *p)
+{
+	return p;
+}
+
+static void b_create_join(void *p, long n)
+{
+	pthread_t t;
+	while (n--) {
+		if (pthread_create(&t, p, nop, 0)) {
+			perror("pthread_create");
+			exit(1);
+		}
+		pthread_join(t, 0);
+	}
+}
+
+/* two threads handing a token back and forth */
+struct pingpong {
+	pthread_mutex_t m;
+	pthread_cond_t c;
+	long turn, stop;
+};
+
+static void *pong(void *p)
+{
+	struct pingpong *pp = p;
+	pthread_mutex_lock(&pp->m);
+	while (!pp->stop) {
+		if (pp->turn & 1) {
+			pp->turn++;
+			pthread_cond_signal(&pp->c);
+		}
+		pthread_cond_wait(&pp->c, &pp->m);
+	}
+	pthread_mutex_unlock(&pp->m);
+	return 0;
+}
+
+static void b_pingpong(void *p, long n)
+{
+	struct pingpong *pp = p;
+	pthread_mutex_lock(&pp->m);
+	while (n--) {
+		pp->turn++;
+		pthread_cond_signal(&pp->c);
+		while (pp->turn & 1) pthread_cond_wait(&pp->c, &pp->m);
+	}
+	pthread_mutex_unlock(&pp->m);
+}
+
+void bench_thread(void)
+{
+	pthread_mutex_t m = PTHREAD_MUTEX_INITIALIZER;
+	pthread_mutex_t rm, em;
+	pthread_mutexattr_t ma;
+	pthread_spinlock_t s;
+	pthread_rwlock_t l = PTHREAD_RWLOCK_INITIALIZER;
+	pthread_cond_t c = PTHREAD_COND_INITIALIZER;
+	pthread_once_t o = PTHREAD_ONCE_INIT;
+	pthread_attr_t a;
+	pthread_key_t k;
+	struct pingpong pp = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, 0, 0 };
+	pthread_t t;
+	sem_t sem;
+
+	pthread_mutexattr_init(&ma);
+	pthread_mutexattr_settype(&ma, PTHREAD_MUTEX_RECURSIVE);
+	pthread_mutex_init(&rm, &ma);
+	pthread_mutexattr_settype(&ma, PTHREAD_MUTEX_ERRORCHECK);
+	pthread_mutex_init(&em, &ma);
+	pthread_spin_init(&s, 0);
+	sem_init(&sem, 0, 0);
+	pthread_key_create(&k, 0);
+	pthread_attr_init(&a);
+	pthread_attr_setstacksize(&a, 16384);
+
+	bench("mutex/normal", b_mutex, &m, 0);
+	bench("mutex/recursive", b_mutex, &rm, 0);
+	bench("mutex/errorcheck", b_mutex, &em, 0);
+	bench("mutex/trylock", b_trylock, &m, 0);
+	bench("spin", b_spin, &s, 0);
+	bench("rwlock/rd", b_rdlock, &l, 0);
+	bench("rwlock/wr", b_wrlock, &l, 0);
+	bench("cond_signal/nowaiter", b_cond_signal, &c, 0);
+	bench("sem/post_wait", b_sem, &sem, 0);
+	bench("once/done", b_once, &o, 0);
+	bench("getspecific", b_getspecific, &k, 0);
+	bench("setspecific", b_setspecific, &k, 0);
+	bench("self", b_self, 0, 0);
+	bench("create_join/default", b_create_join, 0, 0);
+	bench("create_join/16k", b_create_join, &a, 0);
+
+	if (bench_selected("cond_pingpong")) {
+		if (pthread_create(&t, 0, pong, &pp)) {
+			perror("pthread_create");
+			exit(1);
+		}
+		bench("cond_pingpong", b_pingpong, &pp, 0);
+		pthread_mutex_lock(&pp.m);
+		pp.stop = 1;
+		pthread_cond_signal(&pp.c);
+		pthread_mutex_unlock(&pp.m);
+		pthread_join(t, 0);
+	}
+
+	pthread_attr_destroy(&a);
+	pthread_key_delete(k);
+	sem_destroy(&sem);
+	pthread_spin_destroy(&s);
+	pthread_mutex_destroy(&em);
+	pthread_mutex_destroy(&rm);
+	pthread_mutexattr_destroy(&ma);
+}
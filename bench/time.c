@@ -0,0 +1,129 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <time.h>
+#include "bench.h"
+
+static void b_clock_gettime(void *p, long n)
+{
+	clockid_t clk = *(clockid_t *)p;
+	struct timespec ts;
+	while (n--) {
+		clock_gettime(clk, &ts);
+		CLOBBER(&ts);
+	}
+}
+
+static void b_gettimeofday(void *p, long n)
+{
+	struct timeval tv;
+	while (n--) {
+		gettimeofday(&tv, 0);
+		CLOBBER(&tv);
+	}
+}
+
+static void b_time(void *p, long n)
+{
+	while (n--) CLOBBER(time(0));
+}
+
+/* times spread over a few decades, so conversions see varied dates */
+static time_t when(long n)
+{
+	return 946684800 + (n & 1023) * 987654L;
+}
+
+static void b_gmtime(void *p, long n)
+{
+	struct tm tm;
+	time_t t;
+	while (n--) {
+		t = when(n);
+		CLOBBER(gmtime_r(&t, &tm));
+	}
+}
+
+static void b_localtime(void *p, long n)
+{
+	struct tm tm;
+	time_t t;
+	while (n--) {
+		t = when(n);
+		CLOBBER(localtime_r(&t, &tm));
+	}
+}
+
+static void b_mktime(void *p, long n)
+{
+	struct tm tm, *base = p;
+	while (n--) {
+		tm = *base;
+		tm.tm_mday += n & 255;
+		CLOBBER(mktime(&tm));
+	}
+}
+
+static void b_timegm(void *p, long n)
+{
+	struct tm tm, *base = p;
+	while (n--) {
+		tm = *base;
+		tm.tm_mday += n & 255;
+		CLOBBER(timegm(&tm));
+	}
+}
+
+static void b_strftime(void *p, long n)
+{
+	char buf[64];
+	while (n--) {
+		strftime(buf, sizeof buf, "%Y-%m-%d %H:%M:%S %Z", p);
+		CLOBBER(buf);
+	}
+}
+
+static void b_strftime_http(void *p, long n)
+{
+	char buf[64];
+	while (n--) {
+		strftime(buf, sizeof buf, "%a, %d %b %Y %H:%M:%S GMT", p);
+		CLOBBER(buf);
+	}
+}
+
+static void b_strptime(void *p, long n)
+{
+	struct tm tm;
+	while (n--) CLOBBER(strptime("2021-07-14 09:26:53", "%Y-%m-%d %H:%M:%S", &tm));
+}
+
+void bench_time(void)
+{
+	static const clockid_t clocks[] = { CLOCK_REALTIME, CLOCK_MONOTONIC, CLOCK_PROCESS_CPUTIME_ID };
+	static const char *const clock_names[] = { "realtime", "monotonic", "process_cputime" };
+	struct tm tm;
+	time_t t = when(77);
+	char name[64];
+	size_t i;
+
+	/* a fixed POSIX rule keeps results independent of the host zone */
+	setenv("TZ", "EST5EDT,M3.2.0,M11.1.0", 1);
+	tzset();
+	localtime_r(&t, &tm);
+
+	for (i = 0; i < sizeof clocks / sizeof *clocks; i++) {
+		snprintf(name, sizeof name, "clock_gettime/%s", clock_names[i]);
+		bench(name, b_clock_gettime, (void *)&clocks[i], 0);
+	}
+	bench("gettimeofday", b_gettimeofday, 0, 0);
+	bench("time", b_time, 0, 0);
+	bench("gmtime_r", b_gmtime, 0, 0);
+	bench("localtime_r", b_localtime, 0, 0);
+	bench("mktime", b_mktime, &tm, 0);
+	bench("timegm", b_timegm, &tm, 0);
+	bench("strftime/iso", b_strftime, &tm, 0);
+	bench("strftime/http", b_strftime_http, &tm, 0);
+	bench("strptime", b_strptime, 0, 0);
+}
@@ -0,0 +1,40 @@
+#ifndef _BIBON_AUDIT_H
+#define _BIBON_AUDIT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Per-thread syscall and page-fault auditing, for proving that a hot
+ * path never enters the kernel. While a thread has auditing started,
+ * every syscall libc makes on its behalf is counted by number.
+ * Syscalls made inside a critical section are additionally reported
+ * as violations. Page-fault counts come from getrusage and are
+ * deltas since the start of auditing or of the critical section.
+ * Calls that the vdso serves without entering the kernel are not
+ * syscalls and are not counted. */
+
+#define BIBON_AUDIT_NSYS 512
+
+#define BIBON_AUDIT_ABORT 1
+
+struct bibon_audit {
+	unsigned long long syscalls;
+	unsigned long long violations;
+	long first_violation;
+	long minflt, majflt;
+};
+
+int bibon_audit_start(void);
+void bibon_audit_stop(void);
+int bibon_audit_read(struct bibon_audit *);
+unsigned long long bibon_audit_count(long);
+
+int bibon_audit_critical_enter(int);
+int bibon_audit_critical_exit(struct bibon_audit *);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef _BIBON_CLOCK_H
+#define _BIBON_CLOCK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define __NEED_time_t
+#define __NEED_struct_timespec
+#include <bits/alltypes.h>
+
+/* User-space clock on the cpu's constant-rate counter (the invariant
+ * TSC on x86_64, the generic timer on aarch64), calibrated against
+ * CLOCK_MONOTONIC and kept in step with it by slewing, so that no
+ * read enters the kernel or the vdso. Calibration happens on first
+ * use, taking a few milliseconds, or explicitly at startup through
+ * bibon_clock_init; threads arriving meanwhile wait for it. Where no usable counter exists, the functions
+ * fall back to clock_gettime and bibon_clock_ticks counts
+ * nanoseconds. */
+
+int bibon_clock_init(void);
+unsigned long long bibon_clock_ticks(void);
+unsigned long long bibon_clock_freq(void);
+unsigned long long bibon_clock_ns(void);
+int bibon_clock_gettime(struct timespec *);
+unsigned long long bibon_clock_ticks_to_ns(unsigned long long);
+void bibon_clock_ticks_to_timespec(unsigned long long, struct timespec *);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef _BIBON_LOCKSTAT_H
+#define _BIBON_LOCKSTAT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define __NEED_size_t
+#include <bits/alltypes.h>
+
+/* Opt-in lock contention statistics. While enabled, every blocking
+ * acquisition of a pthread mutex, a pthread rwlock, a stdio FILE lock
+ * (taken by stdio functions or flockfile, but not ftrylockfile) or an
+ * internal libc lock, and every pthread_mutex_trylock, is accounted
+ * to the address of the lock or FILE. Acquisitions that had to wait are counted as
+ * contended and add the time spent waiting, in nanoseconds of
+ * CLOCK_MONOTONIC. Blocking attempts that fail, such as timeouts, are
+ * counted in timedout and failed trylocks in busy; neither counts as
+ * an acquisition or adds wait time. When disabled, the lock paths pay
+ * a single load. */
+
+#define BIBON_LOCKSTAT_MUTEX    0
+#define BIBON_LOCKSTAT_RDLOCK   1
+#define BIBON_LOCKSTAT_WRLOCK   2
+#define BIBON_LOCKSTAT_INTERNAL 3
+#define BIBON_LOCKSTAT_FILE     4
+
+struct bibon_lockstat {
+	const void *lock;
+	int kind;
+	unsigned long long acquired;
+	unsigned long long contended;
+	unsigned long long wait_ns;
+	unsigned long long max_wait_ns;
+	unsigned long long timedout;
+	unsigned long long busy;
+};
+
+int bibon_lockstat_enable(int);
+void bibon_lockstat_reset(void);
+size_t bibon_lockstat_top(struct bibon_lockstat *, size_t);
+int bibon_lockstat_dump(int, size_t);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef _BIBON_PERIODIC_H
+#define _BIBON_PERIODIC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define __NEED_clockid_t
+#define __NEED_time_t
+#define __NEED_struct_timespec
+#include <bits/alltypes.h>
+
+/* Fixed-period task loop. Releases are on an absolute grid of
+ * start + k*period, so lateness never accumulates. Each call to
+ * bibon_periodic_wait blocks until the next release, records how
+ * late the wakeup was, and returns the number of releases that were
+ * skipped because the previous cycle overran them. The histogram
+ * counts lateness in powers of two: bucket 0 holds wakeups late by
+ * less than 1ns, bucket i those late by [2^(i-1), 2^i) ns, and the
+ * last bucket everything beyond. Errors are reported by returning -1
+ * and setting errno. */
+
+#define BIBON_PERIODIC_PRECISE 1
+
+#define BIBON_PERIODIC_HIST 32
+
+struct bibon_periodic {
+	clockid_t clock;
+	int flags;
+	long long period;
+	long long next;
+	unsigned long long cycles;
+	unsigned long long missed;
+	long long last_late;
+	long long max_late;
+	unsigned long long sum_late;
+	unsigned long long hist[BIBON_PERIODIC_HIST];
+};
+
+int bibon_periodic_init(struct bibon_periodic *, clockid_t, const struct timespec *, const struct timespec *, int);
+long bibon_periodic_wait(struct bibon_periodic *);
+void bibon_periodic_reset(struct bibon_periodic *);
+int bibon_periodic_dump(const struct bibon_periodic *, int);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef _BIBON_RT_H
+#define _BIBON_RT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define __NEED_size_t
+#include <bits/alltypes.h>
+
+/* Real-time startup profile, applied by __libc_start_main before
+ * constructors and main run, in static and dynamic programs alike.
+ * It is configured at link time by defining bibon_rt_config, or at
+ * run time through the BIBON_RT environment variable, which takes
+ * precedence and is ignored for secure (setuid) programs. Its value
+ * is a comma-separated list of
+ *
+ *   mlock        mlockall(MCL_CURRENT|MCL_FUTURE)
+ *   vdso         resolve vdso clock_gettime and getcpu eagerly, if used
+ *   strict       terminate if any requested step fails
+ *   stack=SIZE   prefault SIZE bytes of the main thread's stack
+ *   heap=SIZE    reserve SIZE bytes, faulted in, for malloc
+ *   cpu=N[-M]    pin the process to cpus N through M
+ *
+ * where SIZE takes an optional k, m or g suffix. Startup is slower,
+ * but the steady state does not take page faults for the prefaulted
+ * and reserved memory. */
+
+#define BIBON_RT_MLOCK  1
+#define BIBON_RT_VDSO   2
+#define BIBON_RT_STRICT 4
+#define BIBON_RT_STACK  8
+#define BIBON_RT_HEAP   16
+#define BIBON_RT_PIN    32
+
+struct bibon_rt_config {
+	int flags;
+	size_t stack_prefault;
+	size_t heap_reserve;
+	int cpu_first, cpu_last;
+};
+
+extern const struct bibon_rt_config bibon_rt_config;
+
+/* Returns the BIBON_RT_* steps that were requested but failed. */
+int bibon_rt_status(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef _BIBON_SLEEP_H
+#define _BIBON_SLEEP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define __NEED_clockid_t
+#define __NEED_time_t
+#define __NEED_struct_timespec
+#include <bits/alltypes.h>
+
+/* Precise sleep: like clock_nanosleep, but the kernel is only asked
+ * to sleep until a margin before the deadline, and the remainder is
+ * spent spinning on the clock. The margin adapts to the wakeup
+ * latency observed on earlier sleeps. Only CLOCK_REALTIME,
+ * CLOCK_MONOTONIC and CLOCK_BOOTTIME are spun on; other clocks are
+ * passed to clock_nanosleep unchanged. Lowering the calling thread's
+ * timer slack reduces the margin and the time spent spinning; setting
+ * it to 0 restores the default. */
+
+int bibon_nanosleep_precise(clockid_t, int, const struct timespec *, struct timespec *);
+long bibon_sleep_margin(void);
+
+int bibon_timerslack_set(unsigned long);
+long bibon_timerslack_get(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
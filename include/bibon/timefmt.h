@@ -0,0 +1,39 @@
+#ifndef _BIBON_TIMEFMT_H
+#define _BIBON_TIMEFMT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define __NEED_size_t
+#define __NEED_time_t
+#define __NEED_struct_timespec
+#include <bits/alltypes.h>
+
+/* Timestamp formatter for log lines. The format is a strftime format
+ * that may contain one fractional-second conversion, %N for
+ * nanoseconds or %1N through %9N for that many leading digits. The
+ * text around it is formatted once per second and kept in the cache
+ * object; later calls within the same second only rewrite the
+ * fraction. A cache object must not be shared between threads
+ * without locking, so callers normally keep one per thread. A change
+ * of TZ takes effect at the next second. */
+
+#define BIBON_TIMEFMT_UTC 1
+
+struct bibon_timefmt {
+	time_t sec;
+	int flags;
+	unsigned char frac, pre, len, ok;
+	char fmt[2][64];
+	char buf[128];
+};
+
+int bibon_timefmt_init(struct bibon_timefmt *, const char *, int);
+size_t bibon_timefmt(struct bibon_timefmt *, char *, size_t, const struct timespec *);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -219,6 +219,14 @@ void _pthread_cleanup_pop(struct __ptcb *, int);
 struct cpu_set_t;
 int pthread_getaffinity_np(pthread_t, size_t, struct cpu_set_t *);
 int pthread_setaffinity_np(pthread_t, size_t, const struct cpu_set_t *);
+int pthread_attr_getaffinity_np(const pthread_attr_t *, size_t, struct cpu_set_t *);
+int pthread_attr_setaffinity_np(pthread_attr_t *, size_t, const struct cpu_set_t *);
+int pthread_attr_getdeadline_np(const pthread_attr_t *__restrict, unsigned long long *__restrict, unsigned long long *__restrict, unsigned long long *__restrict);
+int pthread_attr_setdeadline_np(pthread_attr_t *, unsigned long long, unsigned long long, unsigned long long);
+int pthread_attr_getprefault_np(const pthread_attr_t *__restrict, int *__restrict);
+int pthread_attr_setprefault_np(pthread_attr_t *, int);
+int pthread_attr_getmlock_np(const pthread_attr_t *__restrict, int *__restrict);
+int pthread_attr_setmlock_np(pthread_attr_t *, int);
 int pthread_getattr_np(pthread_t, pthread_attr_t *);
 int pthread_setname_np(pthread_t, const char *);
 int pthread_getname_np(pthread_t, char *, size_t);
@@ -226,6 +234,17 @@ int pthread_getattr_default_np(pthread_attr_t *);
 int pthread_setattr_default_np(const pthread_attr_t *);
 int pthread_tryjoin_np(pthread_t, void **);
 int pthread_timedjoin_np(pthread_t, void **, const struct timespec *);
+#define PTHREAD_RWLOCK_PREFER_READER_NP 0
+#define PTHREAD_RWLOCK_PREFER_WRITER_NP 1
+#define PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP 2
+#define PTHREAD_RWLOCK_SCALABLE_NP 3
+int pthread_rwlockattr_setkind_np(pthread_rwlockattr_t *, int);
+int pthread_rwlockattr_getkind_np(const pthread_rwlockattr_t *__restrict, int *__restrict);
+#define PTHREAD_BARRIER_AUTO_NP 0
+#define PTHREAD_BARRIER_CENTRAL_NP 1
+#define PTHREAD_BARRIER_TREE_NP 2
+int pthread_barrierattr_setkind_np(pthread_barrierattr_t *, int);
+int pthread_barrierattr_getkind_np(const pthread_barrierattr_t *__restrict, int *__restrict);
 #endif
 
 #if _REDIR_TIME64
@@ -95,6 +95,8 @@ extern "C" {
 #define MADV_KEEPONFORK  19
 #define MADV_COLD        20
 #define MADV_PAGEOUT     21
+#define MADV_POPULATE_READ 22
+#define MADV_POPULATE_WRITE 23
 #define MADV_HWPOISON    100
 #define MADV_SOFT_OFFLINE 101
 #endif
@@ -23,6 +23,7 @@
 #include "fork_impl.h"
 #include "libc.h"
 #include "dynlink.h"
+#include "rseq.h"
 
 static size_t ldso_page_size;
 /* libc.h may have defined a macro for dynamic PAGE_SIZE already, but
@@ -129,6 +130,7 @@ static struct builtin_tls {
 	void *space[16];
 } builtin_tls[1];
 #define MIN_TLS_ALIGN offsetof(struct builtin_tls, pt)
+#define SURPLUS_ALIGN 64
 
 #define ADDEND_LIMIT 4096
 static size_t *saved_addends, *apply_addends_to;
@@ -147,7 +149,7 @@ static pthread_rwlock_t lock;
 static struct debug debug;
 static struct tls_module *tls_tail;
 static size_t tls_cnt, tls_offset, tls_align = MIN_TLS_ALIGN;
-static size_t static_tls_cnt;
+static size_t static_tls_cnt, static_tls_end, tls_surplus = 1024;
 static pthread_mutex_t init_fini_lock;
 static pthread_cond_t ctor_cond;
 static struct dso *builtin_deps[2];
@@ -1050,6 +1052,24 @@ static void makefuncdescs(struct dso *p)
 	}
 }
 
+/* Return the offset a TLS module would get if placed after those
+ * already laid out, and store the resulting end of the layout. */
+
+static size_t tls_place(const struct tls_module *m, size_t *end)
+{
+	size_t off;
+#ifdef TLS_ABOVE_TP
+	off = tls_offset + ( (m->align-1) &
+		(-tls_offset + (uintptr_t)m->image) );
+	*end = off + m->size;
+#else
+	off = tls_offset + m->size + m->align - 1;
+	off -= (off + (uintptr_t)m->image) & (m->align-1);
+	*end = off;
+#endif
+	return off;
+}
+
 static struct dso *load_library(const char *name, struct dso *needed_by)
 {
 	char buf[2*NAME_MAX+2];
@@ -1061,6 +1081,7 @@ static struct dso *load_library(const char *name, struct dso *needed_by)
 	size_t alloc_size;
 	int n_th = 0;
 	int is_self = 0;
+	int tls_static = 0;
 
 	if (!*name) {
 		errno = EINVAL;
@@ -1204,8 +1225,17 @@ static struct dso *load_library(const char *name, struct dso *needed_by)
 	 * the newly-loaded DSO. */
 	alloc_size = sizeof *p + strlen(pathname) + 1;
 	if (runtime && temp_dso.tls.image) {
-		size_t per_th = temp_dso.tls.size + temp_dso.tls.align
-			+ sizeof(void *) * (tls_cnt+3);
+		/* A module that fits in the static TLS surplus, which
+		 * every thread already has, only needs the extended DTV.
+		 * Its alignment must not exceed the alignment existing
+		 * threads were laid out with. */
+		size_t end, per_th = sizeof(void *) * (tls_cnt+3);
+		tls_place(&temp_dso.tls, &end);
+		tls_static = tls_cnt == static_tls_cnt
+			&& temp_dso.tls.align <= tls_align
+			&& end <= static_tls_end;
+		if (!tls_static)
+			per_th += temp_dso.tls.size + temp_dso.tls.align;
 		n_th = libc.threads_minus_1 + 1;
 		if (n_th > SSIZE_MAX / per_th) alloc_size = SIZE_MAX;
 		else alloc_size += n_th * per_th;
@@ -1227,16 +1257,8 @@ static struct dso *load_library(const char *name, struct dso *needed_by)
 	if (p->tls.image) {
 		p->tls_id = ++tls_cnt;
 		tls_align = MAXP2(tls_align, p->tls.align);
-#ifdef TLS_ABOVE_TP
-		p->tls.offset = tls_offset + ( (p->tls.align-1) &
-			(-tls_offset + (uintptr_t)p->tls.image) );
-		tls_offset = p->tls.offset + p->tls.size;
-#else
-		tls_offset += p->tls.size + p->tls.align - 1;
-		tls_offset -= (tls_offset + (uintptr_t)p->tls.image)
-			& (p->tls.align-1);
-		p->tls.offset = tls_offset;
-#endif
+		p->tls.offset = tls_place(&p->tls, &tls_offset);
+		if (tls_static) static_tls_cnt = tls_cnt;
 		p->new_dtv = (void *)(-sizeof(size_t) &
 			(uintptr_t)(p->name+strlen(p->name)+sizeof(size_t)));
 		p->new_tls = (void *)(p->new_dtv + n_th*(tls_cnt+1));
@@ -1638,7 +1660,7 @@ static void update_tls_size()
 	libc.tls_align = tls_align;
 	libc.tls_size = ALIGN(
 		(1+tls_cnt) * sizeof(void *) +
-		tls_offset +
+		(tls_offset > static_tls_end ? tls_offset : static_tls_end) +
 		sizeof(struct pthread) +
 		tls_align * 2,
 	tls_align);
@@ -1666,14 +1688,26 @@ static void install_new_tls(void)
 	for (p=head; ; p=p->next) {
 		if (p->tls_id <= old_cnt) continue;
 		unsigned char *mem = p->new_tls;
-		for (j=0; j<i; j++) {
+		for (j=0, td=self; j<i; j++, td=td->next) {
 			unsigned char *new = mem;
-			new += ((uintptr_t)p->tls.image - (uintptr_t)mem)
-				& (p->tls.align-1);
+			if (p->tls_id <= static_tls_cnt) {
+				/* Placed in the static surplus. */
+#ifdef TLS_ABOVE_TP
+				new = (unsigned char *)td + sizeof *td
+					+ p->tls.offset;
+#else
+				new = (unsigned char *)td - p->tls.offset;
+#endif
+				memset(new + p->tls.len, 0,
+					p->tls.size - p->tls.len);
+			} else {
+				new += ((uintptr_t)p->tls.image - (uintptr_t)mem)
+					& (p->tls.align-1);
+				mem += p->tls.size + p->tls.align;
+			}
 			memcpy(new, p->tls.image, p->tls.len);
 			newdtv[j][p->tls_id] =
 				(uintptr_t)new + DTP_OFFSET;
-			mem += p->tls.size + p->tls.align;
 		}
 		if (p->tls_id == tls_cnt) break;
 	}
@@ -1821,6 +1855,13 @@ void __dls3(size_t *sp, size_t *auxv)
 	if (!libc.secure) {
 		env_path = getenv("LD_LIBRARY_PATH");
 		env_preload = getenv("LD_PRELOAD");
+		char *s = getenv("BIBON_TLS_SURPLUS");
+		if (s && *s) {
+			for (tls_surplus=0; *s-'0'<10U; s++)
+				if (tls_surplus < 1<<20)
+					tls_surplus = 10*tls_surplus + *s-'0';
+			if (tls_surplus > 1<<20) tls_surplus = 1<<20;
+		}
 	}
 
 	/* Activate error handler function */
@@ -2008,7 +2049,13 @@ void __dls3(size_t *sp, size_t *auxv)
 	main_ctor_queue = queue_ctors(&app);
 
 	/* Initial TLS must also be allocated before final relocations
-	 * might result in calloc being a call to application code. */
+	 * might result in calloc being a call to application code. It
+	 * includes a surplus in which modules loaded later by dlopen
+	 * can be placed, so that they can use initial-exec TLS. */
+	if (tls_surplus) {
+		static_tls_end = tls_offset + tls_surplus;
+		tls_align = MAXP2(tls_align, SURPLUS_ALIGN);
+	}
 	update_tls_size();
 	void *initial_tls = builtin_tls;
 	if (libc.tls_size > sizeof builtin_tls || tls_align > MIN_TLS_ALIGN) {
@@ -2029,6 +2076,7 @@ void __dls3(size_t *sp, size_t *auxv)
 	/* Actual copying to new TLS needs to happen after relocations,
 	 * since the TLS images might have contained relocated addresses. */
 	if (initial_tls != builtin_tls) {
+		__rseq_unregister(__pthread_self());
 		if (__init_tp(__copy_tls(initial_tls)) < 0) {
 			a_crash();
 		}
@@ -2100,7 +2148,7 @@ void *dlopen(const char *file, int mode)
 {
 	struct dso *volatile p, *orig_tail, *orig_syms_tail, *orig_lazy_head, *next;
 	struct tls_module *orig_tls_tail;
-	size_t orig_tls_cnt, orig_tls_offset, orig_tls_align;
+	size_t orig_tls_cnt, orig_tls_offset, orig_tls_align, orig_static_tls_cnt;
 	size_t i;
 	int cs;
 	jmp_buf jb;
@@ -2124,6 +2172,7 @@ void *dlopen(const char *file, int mode)
 	orig_tls_cnt = tls_cnt;
 	orig_tls_offset = tls_offset;
 	orig_tls_align = tls_align;
+	orig_static_tls_cnt = static_tls_cnt;
 	orig_lazy_head = lazy_head;
 	orig_syms_tail = syms_tail;
 	orig_tail = tail;
@@ -2155,6 +2204,7 @@ void *dlopen(const char *file, int mode)
 		tls_cnt = orig_tls_cnt;
 		tls_offset = orig_tls_offset;
 		tls_align = orig_tls_align;
+		static_tls_cnt = orig_static_tls_cnt;
 		lazy_head = orig_lazy_head;
 		tail = orig_tail;
 		tail->next = 0;
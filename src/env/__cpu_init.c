@@ -0,0 +1,30 @@
+#include <stdlib.h>
+#include <string.h>
+#include "cpu.h"
+
+/* BIBON_CPU lists features to treat as absent, separated by commas,
+ * or "baseline" for all of them, so that a particular variant of a
+ * dispatched routine can be forced for testing and benchmarking.
+ * Features cannot be added this way. */
+
+void __cpu_init(size_t hwcap, int secure)
+{
+	static const struct { char name[8]; unsigned long bit; } names[] = {
+		CPU_FEATURE_NAMES
+	};
+	unsigned long f = __cpu_probe(hwcap);
+	const char *s = secure ? 0 : getenv("BIBON_CPU");
+	size_t i, l;
+
+	for (; s && *s; s += l + !!s[l]) {
+		l = strcspn(s, ",");
+		if (l == 8 && !memcmp(s, "baseline", 8)) f = 0;
+		for (i=0; i<sizeof names/sizeof *names; i++)
+			if (l && l < sizeof names[i].name
+			    && !memcmp(s, names[i].name, l) && !names[i].name[l])
+				f &= ~names[i].bit;
+	}
+	libc.cpu_features = f;
+	libc.cache_size = __cpu_cache_size();
+	libc.cpu_ready = 1;
+}
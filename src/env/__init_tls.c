@@ -8,6 +8,7 @@
 #include "libc.h"
 #include "atomic.h"
 #include "syscall.h"
+#include "rseq.h"
 
 volatile int __thread_list_lock;
 
@@ -24,6 +25,7 @@ int __init_tp(void *p)
 	td->robust_list.head = &td->robust_list.head;
 	td->sysinfo = __sysinfo;
 	td->next = td->prev = td;
+	__rseq_register(td);
 	return 0;
 }
 
@@ -0,0 +1,168 @@
+#define _GNU_SOURCE
+#include <elf.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <bibon/rt.h>
+#include "syscall.h"
+#include "atomic.h"
+#include "libc.h"
+
+extern weak const struct bibon_rt_config bibon_rt_config;
+
+/* Only reserve heap or resolve the vdso functions the program uses,
+ * since this file is linked into every program. */
+static int dummy_reserve(size_t n) { return 0; }
+weak_alias(dummy_reserve, __malloc_reserve);
+static int dummy_getcpu(void) { return 0; }
+weak_alias(dummy_getcpu, __sched_getcpu);
+static int dummy_gettime(clockid_t clk, struct timespec *ts) { return 0; }
+weak_alias(dummy_gettime, __clock_gettime);
+
+static int failed;
+
+static size_t parse_num(const char **s)
+{
+	size_t n = 0;
+	for (; **s-'0' < 10U; ++*s) n = 10*n + (**s-'0');
+	return n;
+}
+
+static size_t parse_size(const char **s)
+{
+	size_t n = parse_num(s);
+	switch (**s|32) {
+	case 'g': n <<= 10;
+	case 'm': n <<= 10;
+	case 'k': n <<= 10;
+		++*s;
+	}
+	return n;
+}
+
+static int match(const char **s, const char *key)
+{
+	size_t l = strlen(key);
+	if (strncmp(*s, key, l)) return 0;
+	if (key[l-1] != '=' && (*s)[l] && (*s)[l] != ',') return 0;
+	*s += l;
+	return 1;
+}
+
+static void parse_env(const char *s, struct bibon_rt_config *c)
+{
+	*c = (struct bibon_rt_config){ 0 };
+	while (*s) {
+		if (match(&s, "mlock")) c->flags |= BIBON_RT_MLOCK;
+		else if (match(&s, "vdso")) c->flags |= BIBON_RT_VDSO;
+		else if (match(&s, "strict")) c->flags |= BIBON_RT_STRICT;
+		else if (match(&s, "stack=")) {
+			c->flags |= BIBON_RT_STACK;
+			c->stack_prefault = parse_size(&s);
+		} else if (match(&s, "heap=")) {
+			c->flags |= BIBON_RT_HEAP;
+			c->heap_reserve = parse_size(&s);
+		} else if (match(&s, "cpu=")) {
+			c->flags |= BIBON_RT_PIN;
+			c->cpu_first = c->cpu_last = parse_num(&s);
+			if (*s == '-') s++, c->cpu_last = parse_num(&s);
+		}
+		while (*s && *s++ != ',');
+	}
+}
+
+#ifdef __GNUC__
+__attribute__((__noinline__))
+#endif
+static void prefault_stack(size_t n)
+{
+	/* Grow the stack by moving the stack pointer rather than by
+	 * touching below it, which some kernels refuse. */
+	volatile char buf[n];
+	for (size_t i=0; i<n; i+=PAGE_SIZE) buf[i] = 0;
+	buf[n-1] = 0;
+}
+
+/* The argument and environment strings and the auxiliary vector
+ * sit at the top of the stack, above the frames already in use. */
+static size_t stack_used(char **envp)
+{
+	uintptr_t top = (uintptr_t)envp;
+	size_t i;
+	for (i=0; envp[i]; i++)
+		if ((uintptr_t)envp[i] > top) top = (uintptr_t)envp[i];
+	for (i=0; libc.auxv[i]; i+=2)
+		if (libc.auxv[i] == AT_EXECFN && libc.auxv[i+1] > top)
+			top = libc.auxv[i+1];
+	return top - (uintptr_t)&top;
+}
+
+static int pin(int first, int last)
+{
+	unsigned long set[1024/(8*sizeof(long))] = { 0 };
+	int i;
+	if (first < 0 || last < first || last >= 8*sizeof set) return -1;
+	for (i=first; i<=last; i++)
+		set[i/(8*sizeof(long))] |= 1UL << i%(8*sizeof(long));
+	return __syscall(SYS_sched_setaffinity, 0, sizeof set, set);
+}
+
+void __rt_init(char **envp)
+{
+	struct bibon_rt_config env;
+	const struct bibon_rt_config *c = 0;
+	size_t i;
+
+	if (!libc.secure) for (i=0; envp[i]; i++)
+		if (!strncmp(envp[i], "BIBON_RT=", 9)) {
+			parse_env(envp[i]+9, &env);
+			c = &env;
+		}
+	if (!c && &bibon_rt_config) c = &bibon_rt_config;
+	if (!c || !c->flags) return;
+
+	if ((c->flags & BIBON_RT_PIN) && pin(c->cpu_first, c->cpu_last))
+		failed |= BIBON_RT_PIN;
+
+	if ((c->flags & BIBON_RT_MLOCK)
+	    && __syscall(SYS_mlockall, MCL_CURRENT|MCL_FUTURE))
+		failed |= BIBON_RT_MLOCK;
+
+	if ((c->flags & BIBON_RT_STACK) && c->stack_prefault) {
+		/* Leave room below the prefaulted part for the program
+		 * to actually use, and never run into the stack limit. */
+		struct rlimit rl;
+		size_t n = c->stack_prefault;
+		if (!getrlimit(RLIMIT_STACK, &rl) && rl.rlim_cur != RLIM_INFINITY) {
+			size_t room = rl.rlim_cur - rl.rlim_cur/8;
+			size_t used = stack_used(envp);
+			room = room > used ? room - used : 0;
+			if (n > room) {
+				n = room;
+				failed |= BIBON_RT_STACK;
+			}
+		}
+		if (n) prefault_stack(n);
+	}
+
+	if ((c->flags & BIBON_RT_HEAP) && c->heap_reserve
+	    && __malloc_reserve(c->heap_reserve))
+		failed |= BIBON_RT_HEAP;
+
+	if (c->flags & BIBON_RT_VDSO) {
+		struct timespec ts;
+		__clock_gettime(CLOCK_MONOTONIC, &ts);
+		__sched_getcpu();
+	}
+
+	if (failed && (c->flags & BIBON_RT_STRICT)) a_crash();
+}
+
+int bibon_rt_status(void)
+{
+	return failed;
+}
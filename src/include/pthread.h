@@ -25,5 +25,12 @@ hidden int __pthread_rwlock_wrlock(pthread_rwlock_t *);
 hidden int __pthread_rwlock_trywrlock(pthread_rwlock_t *);
 hidden int __pthread_rwlock_timedwrlock(pthread_rwlock_t *__restrict, const struct timespec *__restrict);
 hidden int __pthread_rwlock_unlock(pthread_rwlock_t *);
+hidden int __pthread_rwlock_unlock_word(pthread_rwlock_t *);
+hidden int __pthread_rwlock_ind_tryrdlock(pthread_rwlock_t *);
+hidden int __pthread_rwlock_ind_unlock(pthread_rwlock_t *);
+hidden int __pthread_rwlock_ind_drain(pthread_rwlock_t *__restrict, const struct timespec *__restrict, int);
+hidden int __pthread_barrier_tree_init(pthread_barrier_t *, unsigned);
+hidden int __pthread_barrier_tree_wait(pthread_barrier_t *);
+hidden void __pthread_barrier_tree_destroy(pthread_barrier_t *);
 
 #endif
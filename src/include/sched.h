@@ -0,0 +1,8 @@
+#ifndef SCHED_H
+#define SCHED_H
+
+#include "../../include/sched.h"
+
+hidden int __sched_getcpu(void);
+
+#endif
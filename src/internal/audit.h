@@ -0,0 +1,16 @@
+#ifndef AUDIT_H
+#define AUDIT_H
+
+#include <bibon/audit.h>
+
+struct syscall_audit {
+	unsigned long long count[BIBON_AUDIT_NSYS];
+	unsigned long long other, total;
+	int paused, critical, flags;
+	unsigned long long crit_total, crit_violations;
+	long crit_first, first_violation;
+	unsigned long long violations;
+	long minflt, majflt, crit_minflt, crit_majflt;
+};
+
+#endif
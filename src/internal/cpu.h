@@ -0,0 +1,20 @@
+#ifndef CPU_H
+#define CPU_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "libc.h"
+#include "cpu_arch.h"
+
+/* Hot routines with several implementations are called through a
+ * static pointer that initially refers to a resolver. The resolver
+ * picks a variant with CPU_HAS and, once libc.cpu_ready is set,
+ * stores it so later calls go straight to the variant. Calls made
+ * before the probe, from the dynamic linker or early startup, see
+ * no features and get the baseline without caching it. */
+
+#define CPU_HAS(x) ((libc.cpu_features & (x)) == (x))
+
+hidden void __cpu_init(size_t, int);
+
+#endif
@@ -22,11 +22,14 @@ struct __libc {
 	char threaded;
 	char secure;
 	volatile signed char need_locks;
+	char cpu_ready;
 	int threads_minus_1;
 	size_t *auxv;
 	struct tls_module *tls_head;
 	size_t tls_size, tls_align, tls_cnt;
 	size_t page_size;
+	unsigned long cpu_features;
+	size_t cache_size;
 	struct __locale_struct global_locale;
 };
 
@@ -41,6 +44,7 @@ hidden void __init_libc(char **, char *);
 hidden void __init_tls(size_t *);
 hidden void __init_ssp(void *);
 hidden void __libc_start_init(void);
+hidden void __rt_init(char **);
 hidden void __funcs_on_exit(void);
 hidden void __funcs_on_quick_exit(void);
 hidden void __libc_exit_fini(void);
@@ -0,0 +1,27 @@
+#ifndef LOCKSTAT_H
+#define LOCKSTAT_H
+
+#include <features.h>
+#include <bibon/lockstat.h>
+
+#define LOCKSTAT_MUTEX BIBON_LOCKSTAT_MUTEX
+#define LOCKSTAT_RDLOCK BIBON_LOCKSTAT_RDLOCK
+#define LOCKSTAT_WRLOCK BIBON_LOCKSTAT_WRLOCK
+#define LOCKSTAT_INTERNAL BIBON_LOCKSTAT_INTERNAL
+#define LOCKSTAT_FILE BIBON_LOCKSTAT_FILE
+
+extern hidden volatile int __lockstat_on;
+
+hidden long long __lockstat_now(void);
+
+/* r is the result of the attempt. A negative start time marks an
+ * attempt that did not wait; otherwise a successful acquisition is
+ * accounted as contended with the wait since start, and a failed one
+ * as timed out. */
+hidden void __lockstat_record(const volatile void *, int, long long, int);
+hidden unsigned long __lockstat_dropped(void);
+
+#define LOCKSTAT_ACQUIRED(l, k) \
+	(__lockstat_on ? __lockstat_record(l, k, -1, 0) : (void)0)
+
+#endif
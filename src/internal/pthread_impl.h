@@ -58,6 +58,10 @@ struct pthread {
 	volatile int killlock[1];
 	char *dlerror_buf;
 	void *stdio_locks;
+	struct rseq_area *rseq;
+	uint32_t rseq_space[16];
+	struct syscall_audit *audit;
+	volatile int synccall;
 
 	/* Part 3 -- the positions of these fields relative to
 	 * the end of the structure is external and internal ABI. */
@@ -83,6 +87,7 @@ enum {
 #define _a_sched __u.__i[3*__SU+1]
 #define _a_policy __u.__i[3*__SU+2]
 #define _a_prio __u.__i[3*__SU+3]
+#define _a_ext __u.__s[(3*__SU+4)/__SU]
 #define _m_type __u.__i[0]
 #define _m_lock __u.__vi[1]
 #define _m_waiters __u.__vi[2]
@@ -96,15 +101,20 @@ enum {
 #define _c_lock __u.__vi[8]
 #define _c_head __u.__p[1]
 #define _c_tail __u.__p[5]
+#define _c_pi_mutex __u.__p[7/__SU]
+#define _c_pi_seq __u.__vi[9]
 #define _rw_lock __u.__vi[0]
 #define _rw_waiters __u.__vi[1]
 #define _rw_shared __u.__i[2]
+#define _rw_ind __u.__p[3]
+#define _rw_nind __u.__i[4]
 #define _b_lock __u.__vi[0]
 #define _b_waiters __u.__vi[1]
 #define _b_limit __u.__i[2]
 #define _b_count __u.__vi[3]
 #define _b_waiters2 __u.__vi[4]
 #define _b_inst __u.__p[3]
+#define _b_tree __u.__p[4/__SU]
 
 #ifndef TP_OFFSET
 #define TP_OFFSET 0
@@ -145,6 +155,7 @@ hidden void __reset_tls();
 
 hidden void __membarrier_init(void);
 hidden void __dl_thread_cleanup(void);
+hidden void __syscall_audit_exit(pthread_t);
 hidden void __testcancel();
 hidden void __do_cleanup_push(struct __ptcb *);
 hidden void __do_cleanup_pop(struct __ptcb *);
@@ -200,6 +211,21 @@ extern hidden unsigned __default_guardsize;
 #define DEFAULT_STACK_MAX (8<<20)
 #define DEFAULT_GUARD_MAX (1<<20)
 
+/* Non-portable attributes that do not fit in pthread_attr_t live
+ * in an allocation owned by the attribute object, see _a_ext. */
+struct pthread_attr_ext {
+	int flags;
+	unsigned long long dl_runtime, dl_deadline, dl_period;
+	size_t cpusetsize;
+	unsigned char cpuset[];
+};
+
+#define ATTR_PREFAULT 1
+#define ATTR_MLOCK 2
+#define ATTR_DEADLINE 4
+
+hidden struct pthread_attr_ext *__pthread_attr_ext(pthread_attr_t *, size_t);
+
 #define __ATTRP_C11_THREAD ((void*)(uintptr_t)-1)
 
 #endif
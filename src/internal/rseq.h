@@ -0,0 +1,43 @@
+#ifndef RSEQ_H
+#define RSEQ_H
+
+#include <stdint.h>
+#include "pthread_impl.h"
+
+/* Kernel ABI for restartable sequences. The area registered with
+ * the kernel must be 32-byte aligned; it lives inside struct pthread
+ * and td->rseq points at the aligned copy. */
+
+struct rseq_area {
+	uint32_t cpu_id_start;
+	uint32_t cpu_id;
+	uint64_t rseq_cs;
+	uint32_t flags;
+	uint32_t pad[3];
+};
+
+#define RSEQ_AREA_SIZE 32
+#define RSEQ_FLAG_UNREGISTER 1
+#define RSEQ_CPU_ID_UNINITIALIZED ((uint32_t)-1)
+#define RSEQ_CPU_ID_REGISTRATION_FAILED ((uint32_t)-2)
+
+hidden void __rseq_init(void);
+hidden void __rseq_register(pthread_t);
+hidden void __rseq_unregister(pthread_t);
+
+/* Returns the cpu the calling thread is running on, or a negative
+ * value if rseq is not available. The result is only a hint, since
+ * the thread may migrate at any time. */
+static inline int __rseq_cpu(void)
+{
+	return (int)((volatile struct rseq_area *)__pthread_self()->rseq)->cpu_id;
+}
+
+/* Per-cpu data is laid out in cache-line sized slots, one per cpu
+ * the process may run on, so that cpus do not share lines. */
+
+#define PERCPU_LINE 64
+
+hidden int __percpu_slots(void);
+
+#endif
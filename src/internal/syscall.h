@@ -27,13 +27,20 @@ hidden long __syscall_ret(unsigned long),
 	__syscall_cp(syscall_arg_t, syscall_arg_t, syscall_arg_t, syscall_arg_t,
 	             syscall_arg_t, syscall_arg_t, syscall_arg_t);
 
-#define __syscall1(n,a) __syscall1(n,__scc(a))
-#define __syscall2(n,a,b) __syscall2(n,__scc(a),__scc(b))
-#define __syscall3(n,a,b,c) __syscall3(n,__scc(a),__scc(b),__scc(c))
-#define __syscall4(n,a,b,c,d) __syscall4(n,__scc(a),__scc(b),__scc(c),__scc(d))
-#define __syscall5(n,a,b,c,d,e) __syscall5(n,__scc(a),__scc(b),__scc(c),__scc(d),__scc(e))
-#define __syscall6(n,a,b,c,d,e,f) __syscall6(n,__scc(a),__scc(b),__scc(c),__scc(d),__scc(e),__scc(f))
-#define __syscall7(n,a,b,c,d,e,f,g) __syscall7(n,__scc(a),__scc(b),__scc(c),__scc(d),__scc(e),__scc(f),__scc(g))
+/* Syscall auditing: once any thread has enabled it, every syscall
+ * made through these macros is accounted to the calling thread. */
+extern hidden int __syscall_audit_on;
+hidden void __syscall_audit(long);
+#define __SYSCALL_AUDIT(n) (__syscall_audit_on ? __syscall_audit(n) : (void)0)
+
+#define __syscall0(n) (__SYSCALL_AUDIT(n), __syscall0(n))
+#define __syscall1(n,a) (__SYSCALL_AUDIT(n), __syscall1(n,__scc(a)))
+#define __syscall2(n,a,b) (__SYSCALL_AUDIT(n), __syscall2(n,__scc(a),__scc(b)))
+#define __syscall3(n,a,b,c) (__SYSCALL_AUDIT(n), __syscall3(n,__scc(a),__scc(b),__scc(c)))
+#define __syscall4(n,a,b,c,d) (__SYSCALL_AUDIT(n), __syscall4(n,__scc(a),__scc(b),__scc(c),__scc(d)))
+#define __syscall5(n,a,b,c,d,e) (__SYSCALL_AUDIT(n), __syscall5(n,__scc(a),__scc(b),__scc(c),__scc(d),__scc(e)))
+#define __syscall6(n,a,b,c,d,e,f) (__SYSCALL_AUDIT(n), __syscall6(n,__scc(a),__scc(b),__scc(c),__scc(d),__scc(e),__scc(f)))
+#define __syscall7(n,a,b,c,d,e,f,g) (__SYSCALL_AUDIT(n), __syscall7(n,__scc(a),__scc(b),__scc(c),__scc(d),__scc(e),__scc(f),__scc(g)))
 
 #define __SYSCALL_NARGS_X(a,b,c,d,e,f,g,h,n,...) n
 #define __SYSCALL_NARGS(...) __SYSCALL_NARGS_X(__VA_ARGS__,7,6,5,4,3,2,1,0,)
@@ -0,0 +1,17 @@
+#include "pthread_impl.h"
+#include "audit.h"
+
+int __syscall_audit_on;
+
+void __syscall_audit(long n)
+{
+	struct syscall_audit *a = __pthread_self()->audit;
+	if (!a || a->paused) return;
+	if ((unsigned long)n < BIBON_AUDIT_NSYS) a->count[n]++;
+	else a->other++;
+	a->total++;
+	if (!a->critical) return;
+	if (!a->violations++) a->first_violation = n;
+	if (!a->crit_violations++) a->crit_first = n;
+	if (a->flags & BIBON_AUDIT_ABORT) a_crash();
+}
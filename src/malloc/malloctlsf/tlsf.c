@@ -102,14 +102,22 @@ void *TLSF_malloc(struct ControlBlock *control, size_t size) {
 }
 
 void *TLSF_realloc(struct ControlBlock *control, void *address, size_t new_size) {
+    if (address == NULL) {
+        return TLSF_malloc(control, new_size);
+    }
     if (new_size == 0) {
-        TLSF_DEBUG_LOG(indent_tlsf, "Returning null");
+        TLSF_DEBUG_LOG(indent_tlsf, "Freeing block, returning null");
+        TLSF_free(control, address);
         return NULL;
     }
 
+    /* On failure the old block is left untouched. */
     void *new_mem = TLSF_malloc(control, new_size);
+    if (new_mem == NULL) {
+        return NULL;
+    }
     struct BlockHeader *old_block = _get_block_from_pointer(address);
-    size_t old_block_size = _block_size(old_block);
+    size_t old_block_size = _block_size(old_block) - sizeof(struct BlockHeader);
 
     memcpy(new_mem, address, MIN(new_size, old_block_size));
     TLSF_free(control, address);
@@ -460,31 +468,54 @@ void TLSF_INIT() {
     TLSF_Initialized = true;
 }
 
+// Add a block from the OS large enough for an allocation of size
+static bool _grow_pool(size_t size) {
+#ifdef TLSF_ALLOW_SYSCALL_ALLOCATION
+    size_t total_size = size + TLSF_MIN_BLOCK_CREATION;
+    void *newBlock = TLSF_RequestOSMemoryBlock(&total_size);
+    if (newBlock == NULL) {
+        return false;
+    }
+    TLSF_AddMemoryBlock(processSharedControlBlock, newBlock, total_size);
+    return true;
+#else
+    return false;
+#endif /* ifdef TLSF_ALLOW_SYSCALL_ALLOCATION */
+}
+
 void *__libc_malloc(size_t size) {
     TLSF_INIT();
 
     void *mem = TLSF_malloc(processSharedControlBlock, size);
 
-    if (mem == NULL) {
-#ifdef TLSF_ALLOW_SYSCALL_ALLOCATION
-        size_t total_size = size + TLSF_MIN_BLOCK_CREATION;
-        void *newBlock = TLSF_RequestOSMemoryBlock(&total_size);
-        TLSF_AddMemoryBlock(processSharedControlBlock, newBlock, total_size);
+    if (mem == NULL && _grow_pool(size)) {
         mem = TLSF_malloc(processSharedControlBlock, size);
-#endif /* ifdef TLSF_ALLOW_SYSCALL_ALLOCATION */
     }
     return mem;
 }
 
 void *__libc_calloc(size_t nmeb, size_t size) {
+    if (size && nmeb > SIZE_MAX / size) {
+        return NULL;
+    }
+    /* memset switches to streaming stores for very large blocks, so
+     * zeroing them does not flush the cache. */
     void *mem = __libc_malloc(size * nmeb);
-    memset(mem, 0, size * nmeb);
+    if (mem != NULL) {
+        memset(mem, 0, size * nmeb);
+    }
     return mem;
 }
 
 void *__libc_realloc(void *ptr, size_t new_size) {
     TLSF_INIT();
-    return TLSF_realloc(processSharedControlBlock, ptr, new_size);
+
+    void *mem = TLSF_realloc(processSharedControlBlock, ptr, new_size);
+
+    if (mem == NULL && new_size != 0 && _grow_pool(new_size)) {
+        mem = TLSF_realloc(processSharedControlBlock, ptr, new_size);
+    }
+    return mem;
 }
 
 void *__libc_memalign(size_t size, size_t align) {
@@ -502,10 +533,37 @@ void __libc_free(void *ptr) {
 }
 
 void __malloc_donate(char *start, char *end) {
+    /* Gaps reclaimed by the dynamic linker have arbitrary alignment
+     * and size; blocks must start and end on TLSF_BLOCK_SIZE boundaries,
+     * and slivers smaller than a normal pool block only fragment the
+     * free lists. */
+    uintptr_t a = ((uintptr_t)start + TLSF_BLOCK_SIZE - 1) & -(uintptr_t)TLSF_BLOCK_SIZE;
+    uintptr_t b = (uintptr_t)end & -(uintptr_t)TLSF_BLOCK_SIZE;
+    if (b <= a || b - a < TLSF_MIN_BLOCK_CREATION) {
+        return;
+    }
+    start = (char *)a;
+    end = (char *)b;
     TLSF_INIT();
     TLSF_AddMemoryBlock(processSharedControlBlock, (void *)start, end - start);
 }
 
+int __malloc_reserve(size_t n) {
+    /* Add a pool block with every page already faulted in. */
+    if (n > 1u << 30) {
+        n = 1u << 30;
+    }
+    size_t total = n;
+    void *block = TLSF_RequestOSMemoryBlock(&total);
+    if (block == NULL || block == MAP_FAILED) {
+        return -1;
+    }
+    memset(block, 0, total);
+    TLSF_INIT();
+    TLSF_AddMemoryBlock(processSharedControlBlock, block, total);
+    return 0;
+}
+
 int __malloc_replaced = 1;
 int __aligned_alloc_replaced = 1;
 
@@ -18,6 +18,33 @@ double fma(double x, double y, double z)
 
 #else
 
+#include "cpu.h"
+
+hidden double __fma_soft(double, double, double);
+#define fma __fma_soft
 #include "../fma.c"
+#undef fma
+
+static double __fma_fma3(double x, double y, double z)
+{
+	__asm__ ("vfmadd132sd %1, %2, %0" : "+x" (x) : "x" (y), "x" (z));
+	return x;
+}
+
+static double resolve(double, double, double);
+static double (*impl)(double, double, double) = resolve;
+
+static double resolve(double x, double y, double z)
+{
+	double (*f)(double, double, double) = __fma_soft;
+	if (CPU_HAS(CPU_FMA)) f = __fma_fma3;
+	if (libc.cpu_ready) impl = f;
+	return f(x, y, z);
+}
+
+double fma(double x, double y, double z)
+{
+	return impl(x, y, z);
+}
 
 #endif
@@ -18,6 +18,33 @@ float fmaf(float x, float y, float z)
 
 #else
 
+#include "cpu.h"
+
+hidden float __fmaf_soft(float, float, float);
+#define fmaf __fmaf_soft
 #include "../fmaf.c"
+#undef fmaf
+
+static float __fmaf_fma3(float x, float y, float z)
+{
+	__asm__ ("vfmadd132ss %1, %2, %0" : "+x" (x) : "x" (y), "x" (z));
+	return x;
+}
+
+static float resolve(float, float, float);
+static float (*impl)(float, float, float) = resolve;
+
+static float resolve(float x, float y, float z)
+{
+	float (*f)(float, float, float) = __fmaf_soft;
+	if (CPU_HAS(CPU_FMA)) f = __fmaf_fma3;
+	if (libc.cpu_ready) impl = f;
+	return f(x, y, z);
+}
+
+float fmaf(float x, float y, float z)
+{
+	return impl(x, y, z);
+}
 
 #endif
@@ -0,0 +1,99 @@
+#define _GNU_SOURCE
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include "pthread_impl.h"
+#include "audit.h"
+
+/* The audit's own syscalls are kept out of the counts. */
+
+static void faults(struct syscall_audit *a, long *min, long *maj)
+{
+	struct rusage ru;
+	a->paused++;
+	getrusage(RUSAGE_THREAD, &ru);
+	a->paused--;
+	*min = ru.ru_minflt;
+	*maj = ru.ru_majflt;
+}
+
+int bibon_audit_start(void)
+{
+	pthread_t self = __pthread_self();
+	struct syscall_audit *a = self->audit;
+	if (!a) {
+		a = mmap(0, sizeof *a, PROT_READ|PROT_WRITE,
+			MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+		if (a == MAP_FAILED) return -1;
+	} else {
+		self->audit = 0;
+		memset(a, 0, sizeof *a);
+	}
+	a->first_violation = -1;
+	faults(a, &a->minflt, &a->majflt);
+	self->audit = a;
+	a_store(&__syscall_audit_on, 1);
+	return 0;
+}
+
+void __syscall_audit_exit(pthread_t self)
+{
+	struct syscall_audit *a = self->audit;
+	if (!a) return;
+	self->audit = 0;
+	munmap(a, sizeof *a);
+}
+
+void bibon_audit_stop(void)
+{
+	__syscall_audit_exit(__pthread_self());
+}
+
+int bibon_audit_read(struct bibon_audit *r)
+{
+	struct syscall_audit *a = __pthread_self()->audit;
+	if (!a) return -1;
+	faults(a, &r->minflt, &r->majflt);
+	r->minflt -= a->minflt;
+	r->majflt -= a->majflt;
+	r->syscalls = a->total;
+	r->violations = a->violations;
+	r->first_violation = a->first_violation;
+	return 0;
+}
+
+unsigned long long bibon_audit_count(long n)
+{
+	struct syscall_audit *a = __pthread_self()->audit;
+	if (!a) return 0;
+	return (unsigned long)n < BIBON_AUDIT_NSYS ? a->count[n] : a->other;
+}
+
+int bibon_audit_critical_enter(int flags)
+{
+	struct syscall_audit *a = __pthread_self()->audit;
+	if (!a) return -1;
+	if (a->critical++) return 0;
+	a->flags = flags;
+	a->crit_total = a->total;
+	a->crit_violations = 0;
+	a->crit_first = -1;
+	faults(a, &a->crit_minflt, &a->crit_majflt);
+	return 0;
+}
+
+int bibon_audit_critical_exit(struct bibon_audit *r)
+{
+	struct syscall_audit *a = __pthread_self()->audit;
+	if (!a || !a->critical) return -1;
+	if (--a->critical) return 0;
+	if (r) {
+		faults(a, &r->minflt, &r->majflt);
+		r->minflt -= a->crit_minflt;
+		r->majflt -= a->crit_majflt;
+		r->syscalls = a->total - a->crit_total;
+		r->violations = a->crit_violations;
+		r->first_violation = a->crit_first;
+	}
+	return a->crit_violations ? 1 : 0;
+}
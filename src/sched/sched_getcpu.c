@@ -3,6 +3,7 @@
 #include <sched.h>
 #include "syscall.h"
 #include "atomic.h"
+#include "rseq.h"
 
 #ifdef VDSO_GETCPU_SYM
 
@@ -22,11 +23,14 @@ static void *volatile vdso_func = (void *)getcpu_init;
 
 #endif
 
-int sched_getcpu(void)
+int __sched_getcpu(void)
 {
 	int r;
 	unsigned cpu;
 
+	r = __rseq_cpu();
+	if (r >= 0) return r;
+
 #ifdef VDSO_GETCPU_SYM
 	getcpu_f f = (getcpu_f)vdso_func;
 	if (f) {
@@ -40,3 +44,5 @@ int sched_getcpu(void)
 	if (!r) return cpu;
 	return __syscall_ret(r);
 }
+
+weak_alias(__sched_getcpu, sched_getcpu);
@@ -1,5 +1,16 @@
 #include "stdio_impl.h"
 #include "pthread_impl.h"
+#include "lockstat.h"
+
+static void lockfile_contended(FILE *f, int tid)
+{
+	int owner;
+	while ((owner = a_cas(&f->lock, 0, tid|MAYBE_WAITERS))) {
+		if ((owner & MAYBE_WAITERS) ||
+		    a_cas(&f->lock, owner, owner|MAYBE_WAITERS)==owner)
+			__futexwait(&f->lock, owner|MAYBE_WAITERS, 1);
+	}
+}
 
 int __lockfile(FILE *f)
 {
@@ -7,12 +18,17 @@ int __lockfile(FILE *f)
 	if ((owner & ~MAYBE_WAITERS) == tid)
 		return 0;
 	owner = a_cas(&f->lock, 0, tid);
-	if (!owner) return 1;
-	while ((owner = a_cas(&f->lock, 0, tid|MAYBE_WAITERS))) {
-		if ((owner & MAYBE_WAITERS) ||
-		    a_cas(&f->lock, owner, owner|MAYBE_WAITERS)==owner)
-			__futexwait(&f->lock, owner|MAYBE_WAITERS, 1);
+	if (!owner) {
+		LOCKSTAT_ACQUIRED(f, LOCKSTAT_FILE);
+		return 1;
+	}
+	if (!__lockstat_on) {
+		lockfile_contended(f, tid);
+		return 1;
 	}
+	long long t0 = __lockstat_now();
+	lockfile_contended(f, tid);
+	__lockstat_record(f, LOCKSTAT_FILE, t0, 0);
 	return 1;
 }
 
@@ -1,9 +1,13 @@
 #include "stdio_impl.h"
 #include "pthread_impl.h"
+#include "lockstat.h"
 
 void flockfile(FILE *f)
 {
-	if (!ftrylockfile(f)) return;
+	if (!ftrylockfile(f)) {
+		LOCKSTAT_ACQUIRED(f, LOCKSTAT_FILE);
+		return;
+	}
 	__lockfile(f);
 	__register_locked_file(f, __pthread_self());
 }
@@ -1,11 +1,19 @@
 #include <strings.h>
 #include <ctype.h>
 
+/* ASCII letters are folded inline; other bytes go through tolower
+ * so any locale-specific mapping is still honoured. */
+static inline int fold(int c)
+{
+	if (c < 128) return c-'A' < 26U ? c|32 : c;
+	return tolower(c);
+}
+
 int strcasecmp(const char *_l, const char *_r)
 {
 	const unsigned char *l=(void *)_l, *r=(void *)_r;
-	for (; *l && *r && (*l == *r || tolower(*l) == tolower(*r)); l++, r++);
-	return tolower(*l) - tolower(*r);
+	for (; *l && (*l == *r || fold(*l) == fold(*r)); l++, r++);
+	return fold(*l) - fold(*r);
 }
 
 int __strcasecmp_l(const char *l, const char *r, locale_t loc)
@@ -1,10 +1,152 @@
 #define _GNU_SOURCE
 #include <string.h>
+#include <ctype.h>
 
-char *strcasestr(const char *h, const char *n)
+static inline int fold(int c)
 {
-	size_t l = strlen(n);
-	if (!l) return (char *)h;
-	for (; *h; h++) if (!strncasecmp(h, n, l)) return (char *)h;
-	return 0;
+	if (c < 128) return c-'A' < 26U ? c|32 : c;
+	return tolower(c);
+}
+
+#define MAX(a,b) ((a)>(b)?(a):(b))
+
+#define BITOP(a,b,op) \
+ ((a)[(size_t)(b)/(8*sizeof *(a))] op (size_t)1<<((size_t)(b)%(8*sizeof *(a))))
+
+/* Two-Way as in strstr, over case-folded bytes */
+static char *twoway_strcasestr(const unsigned char *h, const unsigned char *n)
+{
+	const unsigned char *z;
+	size_t l, ip, jp, k, p, ms, p0, mem, mem0;
+	size_t byteset[32 / sizeof(size_t)] = { 0 };
+	size_t shift[256];
+	int c;
+
+	/* Computing length of needle and fill shift table */
+	for (l=0; n[l] && h[l]; l++)
+		c = fold(n[l]), BITOP(byteset, c, |=), shift[c] = l+1;
+	if (n[l]) return 0; /* hit the end of h */
+
+	/* Compute maximal suffix */
+	ip = -1; jp = 0; k = p = 1;
+	while (jp+k<l) {
+		if (fold(n[ip+k]) == fold(n[jp+k])) {
+			if (k == p) {
+				jp += p;
+				k = 1;
+			} else k++;
+		} else if (fold(n[ip+k]) > fold(n[jp+k])) {
+			jp += k;
+			k = 1;
+			p = jp - ip;
+		} else {
+			ip = jp++;
+			k = p = 1;
+		}
+	}
+	ms = ip;
+	p0 = p;
+
+	/* And with the opposite comparison */
+	ip = -1; jp = 0; k = p = 1;
+	while (jp+k<l) {
+		if (fold(n[ip+k]) == fold(n[jp+k])) {
+			if (k == p) {
+				jp += p;
+				k = 1;
+			} else k++;
+		} else if (fold(n[ip+k]) < fold(n[jp+k])) {
+			jp += k;
+			k = 1;
+			p = jp - ip;
+		} else {
+			ip = jp++;
+			k = p = 1;
+		}
+	}
+	if (ip+1 > ms+1) ms = ip;
+	else p = p0;
+
+	/* Periodic needle? */
+	if (strncasecmp((void *)n, (void *)(n+p), ms+1)) {
+		mem0 = 0;
+		p = MAX(ms, l-ms-1) + 1;
+	} else mem0 = l-p;
+	mem = 0;
+
+	/* Initialize incremental end-of-haystack pointer */
+	z = h;
+
+	/* Search loop */
+	for (;;) {
+		/* Update incremental end-of-haystack pointer */
+		if (z-h < l) {
+			/* Fast estimate for MAX(l,63) */
+			size_t grow = l | 63;
+			const unsigned char *z2 = memchr(z, 0, grow);
+			if (z2) {
+				z = z2;
+				if (z-h < l) return 0;
+			} else z += grow;
+		}
+
+		/* Check last byte first; advance by shift on mismatch */
+		c = fold(h[l-1]);
+		if (BITOP(byteset, c, &)) {
+			k = l-shift[c];
+			if (k) {
+				if (k < mem) k = mem;
+				h += k;
+				mem = 0;
+				continue;
+			}
+		} else {
+			h += l;
+			mem = 0;
+			continue;
+		}
+
+		/* Compare right half */
+		for (k=MAX(ms+1,mem); n[k] && fold(n[k]) == fold(h[k]); k++);
+		if (n[k]) {
+			h += k-ms;
+			mem = 0;
+			continue;
+		}
+		/* Compare left half */
+		for (k=ms+1; k>mem && fold(n[k-1]) == fold(h[k-1]); k--);
+		if (k <= mem) return (char *)h;
+		h += p;
+		mem = mem0;
+	}
+}
+
+/* Candidates for the first needle byte, in either case, are found
+ * with strcspn and checked directly. Once the checking has cost more
+ * than a constant factor over the scan, the rest of the haystack is
+ * left to Two-Way, which keeps the whole search linear. A non-ASCII
+ * first byte has no short candidate set and goes to Two-Way at once. */
+char *strcasestr(const char *_h, const char *_n)
+{
+	const unsigned char *h = (void *)_h, *n = (void *)_n, *h0 = h;
+	size_t k, work = 0;
+	char set[3];
+	int c = fold(*n);
+
+	if (!c) return (char *)h;
+	if (c >= 128) return twoway_strcasestr(h, n);
+	set[0] = c;
+	set[1] = c-'a' < 26U ? c-32 : 0;
+	set[2] = 0;
+
+	for (;;) {
+		h += strcspn((void *)h, set);
+		if (!*h) return 0;
+		for (k=1; n[k] && fold(n[k]) == fold(h[k]); k++);
+		if (!n[k]) return (char *)h;
+		work += k;
+		if (work > 2*(size_t)(h-h0) + 256)
+			return twoway_strcasestr(h, n);
+		h++;
+	}
 }
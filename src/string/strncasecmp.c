@@ -1,12 +1,18 @@
 #include <strings.h>
 #include <ctype.h>
 
+static inline int fold(int c)
+{
+	if (c < 128) return c-'A' < 26U ? c|32 : c;
+	return tolower(c);
+}
+
 int strncasecmp(const char *_l, const char *_r, size_t n)
 {
 	const unsigned char *l=(void *)_l, *r=(void *)_r;
 	if (!n--) return 0;
-	for (; *l && *r && n && (*l == *r || tolower(*l) == tolower(*r)); l++, r++, n--);
-	return tolower(*l) - tolower(*r);
+	for (; *l && n && (*l == *r || fold(*l) == fold(*r)); l++, r++, n--);
+	return fold(*l) - fold(*r);
 }
 
 int __strncasecmp_l(const char *l, const char *r, size_t n, locale_t loc)
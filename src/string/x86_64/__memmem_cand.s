@@ -0,0 +1,70 @@
+# const unsigned char *__memmem_cand(const unsigned char *h,
+#	const unsigned char *z, const unsigned char *n, size_t l)
+# returns the first p in [h, z-l] with p[0]==n[0] and p[l-1]==n[l-1]
+
+.global __memmem_cand
+.hidden __memmem_cand
+.type __memmem_cand,@function
+__memmem_cand:
+	movzbl (%rdx),%eax
+	movzbl -1(%rdx,%rcx),%r8d
+	lea -1(%rcx),%r9
+	sub %r9,%rsi
+	movd %eax,%xmm1
+	punpcklbw %xmm1,%xmm1
+	punpcklwd %xmm1,%xmm1
+	pshufd $0,%xmm1,%xmm1
+	movd %r8d,%xmm2
+	punpcklbw %xmm2,%xmm2
+	punpcklwd %xmm2,%xmm2
+	pshufd $0,%xmm2,%xmm2
+	lea 16(%rdi),%r10
+	cmp %rsi,%r10
+	ja 3f
+
+1:	movdqu (%rdi),%xmm3
+	movdqu (%rdi,%r9),%xmm4
+	pcmpeqb %xmm1,%xmm3
+	pcmpeqb %xmm2,%xmm4
+	pand %xmm4,%xmm3
+	pmovmskb %xmm3,%r10d
+	test %r10d,%r10d
+	jnz 2f
+	add $16,%rdi
+	lea 16(%rdi),%r10
+	cmp %rsi,%r10
+	jbe 1b
+
+	# fewer than 16 positions left: redo the last full window
+	# and drop the positions already covered
+	cmp %rsi,%rdi
+	jae 9f
+	lea -16(%rsi),%r11
+	movdqu (%r11),%xmm3
+	movdqu (%r11,%r9),%xmm4
+	pcmpeqb %xmm1,%xmm3
+	pcmpeqb %xmm2,%xmm4
+	pand %xmm4,%xmm3
+	pmovmskb %xmm3,%r10d
+	mov %edi,%ecx
+	sub %r11d,%ecx
+	shr %cl,%r10d
+	test %r10d,%r10d
+	jz 9f
+2:	bsf %r10d,%r10d
+	lea (%rdi,%r10),%rax
+	ret
+
+3:	cmp %rsi,%rdi
+	jae 9f
+4:	cmp (%rdi),%al
+	jne 5f
+	cmp (%rdi,%r9),%r8b
+	je 6f
+5:	inc %rdi
+	cmp %rsi,%rdi
+	jb 4b
+9:	xor %eax,%eax
+	ret
+6:	mov %rdi,%rax
+	ret
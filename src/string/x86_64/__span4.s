@@ -0,0 +1,57 @@
+# size_t __span4(const char *s, uint32_t set, unsigned inv)
+# length of the initial segment of s containing no byte of the
+# four packed in set (inv=0), or only such bytes (inv=0xffff)
+
+.global __span4
+.hidden __span4
+.type __span4,@function
+__span4:
+	movd %esi,%xmm0
+	punpcklbw %xmm0,%xmm0
+	punpcklwd %xmm0,%xmm0
+	pshufd $0x00,%xmm0,%xmm1
+	pshufd $0x55,%xmm0,%xmm2
+	pshufd $0xaa,%xmm0,%xmm3
+	pshufd $0xff,%xmm0,%xmm4
+	mov %rdi,%rax
+	mov %edi,%ecx
+	and $-16,%rax
+	and $15,%ecx
+	movdqa (%rax),%xmm0
+	movdqa %xmm0,%xmm5
+	movdqa %xmm0,%xmm6
+	movdqa %xmm0,%xmm7
+	pcmpeqb %xmm1,%xmm0
+	pcmpeqb %xmm2,%xmm5
+	pcmpeqb %xmm3,%xmm6
+	pcmpeqb %xmm4,%xmm7
+	por %xmm5,%xmm0
+	por %xmm7,%xmm6
+	por %xmm6,%xmm0
+	pmovmskb %xmm0,%r8d
+	xor %edx,%r8d
+	shr %cl,%r8d
+	test %r8d,%r8d
+	jz 1f
+	bsf %r8d,%eax
+	ret
+
+1:	add $16,%rax
+	movdqa (%rax),%xmm0
+	movdqa %xmm0,%xmm5
+	movdqa %xmm0,%xmm6
+	movdqa %xmm0,%xmm7
+	pcmpeqb %xmm1,%xmm0
+	pcmpeqb %xmm2,%xmm5
+	pcmpeqb %xmm3,%xmm6
+	pcmpeqb %xmm4,%xmm7
+	por %xmm5,%xmm0
+	por %xmm7,%xmm6
+	por %xmm6,%xmm0
+	pmovmskb %xmm0,%r8d
+	xor %edx,%r8d
+	jz 1b
+	bsf %r8d,%r8d
+	add %r8,%rax
+	sub %rdi,%rax
+	ret
@@ -0,0 +1,82 @@
+# size_t __span_tbl(const char *s, const unsigned char *tbl, unsigned inv)
+# as __span4, for an arbitrary byte set given as a bitmap indexed by
+# low nibble: tbl[l] has bit h set for byte h<<4|l with h<8, and
+# tbl[16+l] bit h-8 for h>=8. Needs SSSE3.
+
+.global __span_tbl
+.hidden __span_tbl
+.type __span_tbl,@function
+__span_tbl:
+	movdqu (%rsi),%xmm6
+	movdqu 16(%rsi),%xmm7
+	mov $0x8040201008040201,%rax
+	movq %rax,%xmm5
+	punpcklqdq %xmm5,%xmm5
+	mov $0x0f0f0f0f,%eax
+	movd %eax,%xmm4
+	pshufd $0,%xmm4,%xmm4
+	mov $0x8f8f8f8f,%eax
+	movd %eax,%xmm8
+	pshufd $0,%xmm8,%xmm8
+	mov $0x80808080,%eax
+	movd %eax,%xmm9
+	pshufd $0,%xmm9,%xmm9
+	pxor %xmm10,%xmm10
+	xor $0xffff,%edx
+	mov %rdi,%rax
+	mov %edi,%ecx
+	and $-16,%rax
+	and $15,%ecx
+	# a byte is in the set when the bit for its high nibble is set
+	# in its low nibble's row; pshufb yields 0 for indices with the
+	# top bit set, which picks the row half without a blend
+	movdqa (%rax),%xmm0
+	movdqa %xmm0,%xmm1
+	psrlw $4,%xmm1
+	pand %xmm4,%xmm1
+	movdqa %xmm0,%xmm2
+	pand %xmm8,%xmm2
+	pxor %xmm9,%xmm0
+	pand %xmm8,%xmm0
+	movdqa %xmm6,%xmm3
+	pshufb %xmm2,%xmm3
+	movdqa %xmm7,%xmm2
+	pshufb %xmm0,%xmm2
+	por %xmm3,%xmm2
+	movdqa %xmm5,%xmm0
+	pshufb %xmm1,%xmm0
+	pand %xmm0,%xmm2
+	pcmpeqb %xmm10,%xmm2
+	pmovmskb %xmm2,%r8d
+	xor %edx,%r8d
+	shr %cl,%r8d
+	test %r8d,%r8d
+	jz 1f
+	bsf %r8d,%eax
+	ret
+
+1:	add $16,%rax
+	movdqa (%rax),%xmm0
+	movdqa %xmm0,%xmm1
+	psrlw $4,%xmm1
+	pand %xmm4,%xmm1
+	movdqa %xmm0,%xmm2
+	pand %xmm8,%xmm2
+	pxor %xmm9,%xmm0
+	pand %xmm8,%xmm0
+	movdqa %xmm6,%xmm3
+	pshufb %xmm2,%xmm3
+	movdqa %xmm7,%xmm2
+	pshufb %xmm0,%xmm2
+	por %xmm3,%xmm2
+	movdqa %xmm5,%xmm0
+	pshufb %xmm1,%xmm0
+	pand %xmm0,%xmm2
+	pcmpeqb %xmm10,%xmm2
+	pmovmskb %xmm2,%r8d
+	xor %edx,%r8d
+	jz 1b
+	bsf %r8d,%r8d
+	add %r8,%rax
+	sub %rdi,%rax
+	ret
@@ -0,0 +1,96 @@
+# const unsigned char *__strstr_cand(const unsigned char *h,
+#	const unsigned char *n, size_t l)
+# returns the first p >= h with p[0]==n[0] and p[l-1]==n[l-1] that
+# lies before the end of the string, which must not end before h+l-1.
+# The last-byte stream is read with aligned loads, so nothing past
+# the terminating null is touched beyond its 16-byte block.
+
+.global __strstr_cand
+.hidden __strstr_cand
+.type __strstr_cand,@function
+__strstr_cand:
+	movzbl (%rsi),%eax
+	movzbl -1(%rsi,%rdx),%r8d
+	lea -1(%rdx),%r9
+	movd %eax,%xmm1
+	punpcklbw %xmm1,%xmm1
+	punpcklwd %xmm1,%xmm1
+	pshufd $0,%xmm1,%xmm1
+	movd %r8d,%xmm2
+	punpcklbw %xmm2,%xmm2
+	punpcklwd %xmm2,%xmm2
+	pshufd $0,%xmm2,%xmm2
+	pxor %xmm0,%xmm0
+
+	# r10: aligned block holding the last byte of the first window
+	# r11: start of the corresponding first-byte window
+	lea (%rdi,%r9),%rcx
+	mov %rcx,%r10
+	and $-16,%r10
+	and $15,%ecx
+	mov %r10,%r11
+	sub %r9,%r11
+	mov %r11,%rdx
+	xor %rdi,%rdx
+	shr $12,%rdx
+	jnz 5f
+
+	movdqa (%r10),%xmm4
+	movdqu (%r11),%xmm3
+	movdqa %xmm4,%xmm5
+	pcmpeqb %xmm0,%xmm5
+	pcmpeqb %xmm2,%xmm4
+	pcmpeqb %xmm1,%xmm3
+	pand %xmm4,%xmm3
+	pmovmskb %xmm3,%edx
+	pmovmskb %xmm5,%esi
+	mov $-1,%eax
+	shl %cl,%eax
+	and %eax,%edx
+	and %eax,%esi
+	jmp 2f
+
+1:	add $16,%r10
+	add $16,%r11
+	movdqa (%r10),%xmm4
+	movdqu (%r11),%xmm3
+	movdqa %xmm4,%xmm5
+	pcmpeqb %xmm0,%xmm5
+	pcmpeqb %xmm2,%xmm4
+	pcmpeqb %xmm1,%xmm3
+	pand %xmm4,%xmm3
+	pmovmskb %xmm3,%edx
+	pmovmskb %xmm5,%esi
+2:	test %esi,%esi
+	jnz 3f
+	test %edx,%edx
+	jz 1b
+4:	bsf %edx,%edx
+	lea (%r11,%rdx),%rax
+	ret
+
+	# only candidates before the null count
+3:	lea -1(%rsi),%eax
+	xor %eax,%esi
+	and %esi,%edx
+	jnz 4b
+9:	xor %eax,%eax
+	ret
+
+	# the first-byte window would start on the previous page:
+	# walk the first block a byte at a time
+5:	mov %rdi,%rdx
+6:	movzbl (%rdx,%r9),%esi
+	test %esi,%esi
+	jz 9b
+	cmp %r8d,%esi
+	jne 7f
+	cmp (%rdx),%al
+	jne 7f
+	mov %rdx,%rax
+	ret
+7:	inc %rdx
+	lea (%rdx,%r9),%rsi
+	test $15,%sil
+	jnz 6b
+	jmp 1b
@@ -0,0 +1,21 @@
+#include <string.h>
+#include "cpu.h"
+
+hidden void *__memchr_sse2(const void *, int, size_t);
+hidden void *__memchr_avx2(const void *, int, size_t);
+
+static void *resolve(const void *, int, size_t);
+static void *(*impl)(const void *, int, size_t) = resolve;
+
+static void *resolve(const void *s, int c, size_t n)
+{
+	void *(*f)(const void *, int, size_t) = __memchr_sse2;
+	if (CPU_HAS(CPU_AVX2)) f = __memchr_avx2;
+	if (libc.cpu_ready) impl = f;
+	return f(s, c, n);
+}
+
+void *memchr(const void *s, int c, size_t n)
+{
+	return impl(s, c, n);
+}
@@ -0,0 +1,77 @@
+.global __memchr_avx2
+.hidden __memchr_avx2
+.type __memchr_avx2,@function
+__memchr_avx2:
+	test %rdx,%rdx
+	jz 7f
+	mov %rdx,%r9
+	vmovd %esi,%xmm0
+	vpbroadcastb %xmm0,%ymm0
+	mov %rdi,%rax
+	mov %edi,%ecx
+	and $-32,%rax
+	and $31,%ecx
+	add %rcx,%rdx
+	jnc 1f
+	mov $-1,%rdx
+1:	vpcmpeqb (%rax),%ymm0,%ymm1
+	vpmovmskb %ymm1,%r8d
+	shr %cl,%r8d
+	test %r8d,%r8d
+	jz 2f
+	bsf %r8d,%r8d
+	cmp %r9,%r8
+	jae 7f
+	lea (%rdi,%r8),%rax
+	vzeroupper
+	ret
+
+	# rdx is the number of bytes in range from the block at rax
+2:	cmp $32,%rdx
+	jbe 7f
+	add $32,%rax
+	sub $32,%rdx
+	test $127,%al
+	jz 4f
+	vpcmpeqb (%rax),%ymm0,%ymm1
+	vpmovmskb %ymm1,%r8d
+	test %r8d,%r8d
+	jz 2b
+	jmp 6f
+
+4:	cmp $128,%rdx
+	jbe 5f
+	vpcmpeqb (%rax),%ymm0,%ymm1
+	vpcmpeqb 32(%rax),%ymm0,%ymm2
+	vpcmpeqb 64(%rax),%ymm0,%ymm3
+	vpcmpeqb 96(%rax),%ymm0,%ymm4
+	vpor %ymm2,%ymm1,%ymm1
+	vpor %ymm4,%ymm3,%ymm3
+	vpor %ymm3,%ymm1,%ymm1
+	vpmovmskb %ymm1,%r8d
+	test %r8d,%r8d
+	jnz 5f
+	sub $-128,%rax
+	add $-128,%rdx
+	jmp 4b
+
+5:	vpcmpeqb (%rax),%ymm0,%ymm1
+	vpmovmskb %ymm1,%r8d
+	test %r8d,%r8d
+	jnz 6f
+	cmp $32,%rdx
+	jbe 7f
+	add $32,%rax
+	sub $32,%rdx
+	jmp 5b
+
+6:	bsf %r8d,%r8d
+	cmp %rdx,%r8
+	jae 7f
+	add %r8,%rax
+	vzeroupper
+	ret
+
+7:	xor %eax,%eax
+	vzeroupper
+	ret
@@ -0,0 +1,83 @@
+.global __memchr_sse2
+.hidden __memchr_sse2
+.type __memchr_sse2,@function
+__memchr_sse2:
+	test %rdx,%rdx
+	jz 7f
+	mov %rdx,%r9
+	movd %esi,%xmm0
+	punpcklbw %xmm0,%xmm0
+	punpcklwd %xmm0,%xmm0
+	pshufd $0,%xmm0,%xmm0
+	mov %rdi,%rax
+	mov %edi,%ecx
+	and $-16,%rax
+	and $15,%ecx
+	add %rcx,%rdx
+	jnc 1f
+	mov $-1,%rdx
+1:	movdqa (%rax),%xmm1
+	pcmpeqb %xmm0,%xmm1
+	pmovmskb %xmm1,%r8d
+	shr %cl,%r8d
+	test %r8d,%r8d
+	jz 2f
+	bsf %r8d,%r8d
+	cmp %r9,%r8
+	jae 7f
+	lea (%rdi,%r8),%rax
+	ret
+
+	# rdx is the number of bytes in range from the block at rax
+2:	cmp $16,%rdx
+	jbe 7f
+	add $16,%rax
+	sub $16,%rdx
+	test $63,%al
+	jz 4f
+	movdqa (%rax),%xmm1
+	pcmpeqb %xmm0,%xmm1
+	pmovmskb %xmm1,%r8d
+	test %r8d,%r8d
+	jz 2b
+	jmp 6f
+
+4:	cmp $64,%rdx
+	jbe 5f
+	movdqa (%rax),%xmm1
+	movdqa 16(%rax),%xmm2
+	movdqa 32(%rax),%xmm3
+	movdqa 48(%rax),%xmm4
+	pcmpeqb %xmm0,%xmm1
+	pcmpeqb %xmm0,%xmm2
+	pcmpeqb %xmm0,%xmm3
+	pcmpeqb %xmm0,%xmm4
+	por %xmm2,%xmm1
+	por %xmm4,%xmm3
+	por %xmm3,%xmm1
+	pmovmskb %xmm1,%r8d
+	test %r8d,%r8d
+	jnz 5f
+	add $64,%rax
+	sub $64,%rdx
+	jmp 4b
+
+5:	movdqa (%rax),%xmm1
+	pcmpeqb %xmm0,%xmm1
+	pmovmskb %xmm1,%r8d
+	test %r8d,%r8d
+	jnz 6f
+	cmp $16,%rdx
+	jbe 7f
+	add $16,%rax
+	sub $16,%rdx
+	jmp 5b
+
+6:	bsf %r8d,%r8d
+	cmp %rdx,%r8
+	jae 7f
+	add %r8,%rax
+	ret
+
+7:	xor %eax,%eax
+	ret
@@ -0,0 +1,85 @@
+.global memcmp
+.type memcmp,@function
+memcmp:
+	cmp $16,%rdx
+	jb 4f
+	xor %ecx,%ecx
+	sub $16,%rdx
+
+	# compare 16-byte blocks at rcx, then one final block
+	# ending at n, which may overlap the previous one
+1:	movdqu (%rdi,%rcx),%xmm0
+	movdqu (%rsi,%rcx),%xmm1
+	pcmpeqb %xmm1,%xmm0
+	pmovmskb %xmm0,%eax
+	xor $0xffff,%eax
+	jnz 3f
+	add $16,%rcx
+	cmp %rdx,%rcx
+	jb 1b
+	mov %rdx,%rcx
+	movdqu (%rdi,%rcx),%xmm0
+	movdqu (%rsi,%rcx),%xmm1
+	pcmpeqb %xmm1,%xmm0
+	pmovmskb %xmm0,%eax
+	xor $0xffff,%eax
+	jnz 3f
+2:	ret
+
+3:	bsf %eax,%eax
+	add %rax,%rcx
+	movzbl (%rdi,%rcx),%eax
+	movzbl (%rsi,%rcx),%edx
+	sub %edx,%eax
+	ret
+
+4:	cmp $8,%edx
+	jb 6f
+	mov (%rdi),%rax
+	mov (%rsi),%rcx
+	cmp %rcx,%rax
+	jne 5f
+	mov -8(%rdi,%rdx),%rax
+	mov -8(%rsi,%rdx),%rcx
+	cmp %rcx,%rax
+	jne 5f
+	xor %eax,%eax
+	ret
+5:	bswap %rax
+	bswap %rcx
+	cmp %rcx,%rax
+	sbb %eax,%eax
+	or $1,%eax
+	ret
+
+6:	cmp $4,%edx
+	jb 8f
+	mov (%rdi),%eax
+	mov (%rsi),%ecx
+	cmp %ecx,%eax
+	jne 7f
+	mov -4(%rdi,%rdx),%eax
+	mov -4(%rsi,%rdx),%ecx
+	cmp %ecx,%eax
+	jne 7f
+	xor %eax,%eax
+	ret
+7:	bswap %eax
+	bswap %ecx
+	cmp %ecx,%eax
+	sbb %eax,%eax
+	or $1,%eax
+	ret
+
+8:	xor %eax,%eax
+	test %edx,%edx
+	jz 2b
+9:	movzbl (%rdi),%eax
+	movzbl (%rsi),%ecx
+	sub %ecx,%eax
+	jnz 2b
+	inc %rdi
+	inc %rsi
+	dec %edx
+	jnz 9b
+	ret
@@ -0,0 +1,42 @@
+#include <string.h>
+#include <stdint.h>
+#include "cpu.h"
+
+hidden void *__memcpy_sse2(void *restrict, const void *restrict, size_t);
+hidden void *__memcpy_avx2(void *restrict, const void *restrict, size_t);
+
+/* Copies above 256 bytes use rep movsb from the first threshold on
+ * (ERMS only) and streaming stores from the second, set to most of
+ * the outermost cache so that a copy cannot evict everything else.
+ * Until the features are known, neither is used. */
+
+hidden size_t __memcpy_rep_threshold = SIZE_MAX;
+hidden size_t __memcpy_nt_threshold = SIZE_MAX;
+
+hidden void __memcpy_tune(void)
+{
+	if (!libc.cpu_ready) return;
+	if (CPU_HAS(CPU_ERMS))
+		__memcpy_rep_threshold = CPU_HAS(CPU_AVX2) ? 4096 : 2048;
+	if (libc.cache_size)
+		__memcpy_nt_threshold = libc.cache_size / 4 * 3;
+}
+
+static void *resolve(void *restrict, const void *restrict, size_t);
+static void *(*impl)(void *restrict, const void *restrict, size_t) = resolve;
+
+static void *resolve(void *restrict d, const void *restrict s, size_t n)
+{
+	void *(*f)(void *restrict, const void *restrict, size_t) = __memcpy_sse2;
+	if (CPU_HAS(CPU_AVX2)) f = __memcpy_avx2;
+	if (libc.cpu_ready) {
+		__memcpy_tune();
+		impl = f;
+	}
+	return f(d, s, n);
+}
+
+void *memcpy(void *restrict d, const void *restrict s, size_t n)
+{
+	return impl(d, s, n);
+}
@@ -0,0 +1,163 @@
+.global __memcpy_avx2
+.hidden __memcpy_avx2
+.hidden __memcpy_rep_threshold
+.hidden __memcpy_nt_threshold
+.type __memcpy_avx2,@function
+__memcpy_avx2:
+	mov %rdi,%rax
+	cmp $16,%rdx
+	jb 5f
+	cmp $32,%rdx
+	ja 1f
+	vmovdqu (%rsi),%xmm0
+	vmovdqu -16(%rsi,%rdx),%xmm1
+	vmovdqu %xmm0,(%rdi)
+	vmovdqu %xmm1,-16(%rdi,%rdx)
+	ret
+
+1:	cmp $64,%rdx
+	ja 1f
+	vmovdqu (%rsi),%ymm0
+	vmovdqu -32(%rsi,%rdx),%ymm1
+	vmovdqu %ymm0,(%rdi)
+	vmovdqu %ymm1,-32(%rdi,%rdx)
+	vzeroupper
+	ret
+
+1:	cmp $128,%rdx
+	ja 1f
+	vmovdqu (%rsi),%ymm0
+	vmovdqu 32(%rsi),%ymm1
+	vmovdqu -64(%rsi,%rdx),%ymm2
+	vmovdqu -32(%rsi,%rdx),%ymm3
+	vmovdqu %ymm0,(%rdi)
+	vmovdqu %ymm1,32(%rdi)
+	vmovdqu %ymm2,-64(%rdi,%rdx)
+	vmovdqu %ymm3,-32(%rdi,%rdx)
+	vzeroupper
+	ret
+
+1:	cmp $256,%rdx
+	ja 1f
+	vmovdqu (%rsi),%ymm0
+	vmovdqu 32(%rsi),%ymm1
+	vmovdqu 64(%rsi),%ymm2
+	vmovdqu 96(%rsi),%ymm3
+	vmovdqu -128(%rsi,%rdx),%ymm4
+	vmovdqu -96(%rsi,%rdx),%ymm5
+	vmovdqu -64(%rsi,%rdx),%ymm6
+	vmovdqu -32(%rsi,%rdx),%ymm7
+	vmovdqu %ymm0,(%rdi)
+	vmovdqu %ymm1,32(%rdi)
+	vmovdqu %ymm2,64(%rdi)
+	vmovdqu %ymm3,96(%rdi)
+	vmovdqu %ymm4,-128(%rdi,%rdx)
+	vmovdqu %ymm5,-96(%rdi,%rdx)
+	vmovdqu %ymm6,-64(%rdi,%rdx)
+	vmovdqu %ymm7,-32(%rdi,%rdx)
+	vzeroupper
+	ret
+
+1:	cmp __memcpy_nt_threshold(%rip),%rdx
+	jae 3f
+	cmp __memcpy_rep_threshold(%rip),%rdx
+	jae 4f
+
+	# the first 32 and last 128 bytes are copied from registers
+	# loaded up front; the loop stores to 32-aligned destinations
+	vmovdqu (%rsi),%ymm8
+	vmovdqu -128(%rsi,%rdx),%ymm4
+	vmovdqu -96(%rsi,%rdx),%ymm5
+	vmovdqu -64(%rsi,%rdx),%ymm6
+	vmovdqu -32(%rsi,%rdx),%ymm7
+	lea -128(%rdi,%rdx),%r9
+	lea 32(%rdi),%rcx
+	and $-32,%rcx
+	sub %rdi,%rcx
+	add %rcx,%rsi
+	add %rcx,%rdi
+2:	vmovdqu (%rsi),%ymm0
+	vmovdqu 32(%rsi),%ymm1
+	vmovdqu 64(%rsi),%ymm2
+	vmovdqu 96(%rsi),%ymm3
+	vmovdqa %ymm0,(%rdi)
+	vmovdqa %ymm1,32(%rdi)
+	vmovdqa %ymm2,64(%rdi)
+	vmovdqa %ymm3,96(%rdi)
+	sub $-128,%rsi
+	sub $-128,%rdi
+	cmp %r9,%rdi
+	jb 2b
+	vmovdqu %ymm4,(%r9)
+	vmovdqu %ymm5,32(%r9)
+	vmovdqu %ymm6,64(%r9)
+	vmovdqu %ymm7,96(%r9)
+	vmovdqu %ymm8,(%rax)
+	vzeroupper
+	ret
+
+3:	vmovdqu (%rsi),%ymm8
+	vmovdqu -128(%rsi,%rdx),%ymm4
+	vmovdqu -96(%rsi,%rdx),%ymm5
+	vmovdqu -64(%rsi,%rdx),%ymm6
+	vmovdqu -32(%rsi,%rdx),%ymm7
+	lea -128(%rdi,%rdx),%r9
+	lea 32(%rdi),%rcx
+	and $-32,%rcx
+	sub %rdi,%rcx
+	add %rcx,%rsi
+	add %rcx,%rdi
+2:	prefetcht0 512(%rsi)
+	prefetcht0 576(%rsi)
+	vmovdqu (%rsi),%ymm0
+	vmovdqu 32(%rsi),%ymm1
+	vmovdqu 64(%rsi),%ymm2
+	vmovdqu 96(%rsi),%ymm3
+	vmovntdq %ymm0,(%rdi)
+	vmovntdq %ymm1,32(%rdi)
+	vmovntdq %ymm2,64(%rdi)
+	vmovntdq %ymm3,96(%rdi)
+	sub $-128,%rsi
+	sub $-128,%rdi
+	cmp %r9,%rdi
+	jb 2b
+	sfence
+	vmovdqu %ymm4,(%r9)
+	vmovdqu %ymm5,32(%r9)
+	vmovdqu %ymm6,64(%r9)
+	vmovdqu %ymm7,96(%r9)
+	vmovdqu %ymm8,(%rax)
+	vzeroupper
+	ret
+
+4:	mov %rdx,%rcx
+	rep
+	movsb
+	ret
+
+5:	cmp $8,%edx
+	jb 1f
+	mov (%rsi),%rcx
+	mov -8(%rsi,%rdx),%r8
+	mov %rcx,(%rdi)
+	mov %r8,-8(%rdi,%rdx)
+	ret
+1:	cmp $4,%edx
+	jb 1f
+	mov (%rsi),%ecx
+	mov -4(%rsi,%rdx),%r8d
+	mov %ecx,(%rdi)
+	mov %r8d,-4(%rdi,%rdx)
+	ret
+1:	cmp $2,%edx
+	jb 1f
+	movzwl (%rsi),%ecx
+	movzwl -2(%rsi,%rdx),%r8d
+	mov %cx,(%rdi)
+	mov %r8w,-2(%rdi,%rdx)
+	ret
+1:	test %edx,%edx
+	jz 1f
+	movzbl (%rsi),%ecx
+	mov %cl,(%rdi)
+1:	ret
@@ -0,0 +1,187 @@
+.global __memcpy_sse2
+.hidden __memcpy_sse2
+.hidden __memcpy_rep_threshold
+.hidden __memcpy_nt_threshold
+.type __memcpy_sse2,@function
+__memcpy_sse2:
+	mov %rdi,%rax
+	cmp $16,%rdx
+	jb 5f
+	cmp $32,%rdx
+	ja 1f
+	movups (%rsi),%xmm0
+	movups -16(%rsi,%rdx),%xmm1
+	movups %xmm0,(%rdi)
+	movups %xmm1,-16(%rdi,%rdx)
+	ret
+
+1:	cmp $64,%rdx
+	ja 1f
+	movups (%rsi),%xmm0
+	movups 16(%rsi),%xmm1
+	movups -32(%rsi,%rdx),%xmm2
+	movups -16(%rsi,%rdx),%xmm3
+	movups %xmm0,(%rdi)
+	movups %xmm1,16(%rdi)
+	movups %xmm2,-32(%rdi,%rdx)
+	movups %xmm3,-16(%rdi,%rdx)
+	ret
+
+1:	cmp $128,%rdx
+	ja 1f
+	movups (%rsi),%xmm0
+	movups 16(%rsi),%xmm1
+	movups 32(%rsi),%xmm2
+	movups 48(%rsi),%xmm3
+	movups -64(%rsi,%rdx),%xmm4
+	movups -48(%rsi,%rdx),%xmm5
+	movups -32(%rsi,%rdx),%xmm6
+	movups -16(%rsi,%rdx),%xmm7
+	movups %xmm0,(%rdi)
+	movups %xmm1,16(%rdi)
+	movups %xmm2,32(%rdi)
+	movups %xmm3,48(%rdi)
+	movups %xmm4,-64(%rdi,%rdx)
+	movups %xmm5,-48(%rdi,%rdx)
+	movups %xmm6,-32(%rdi,%rdx)
+	movups %xmm7,-16(%rdi,%rdx)
+	ret
+
+1:	cmp $256,%rdx
+	ja 1f
+	movups (%rsi),%xmm0
+	movups 16(%rsi),%xmm1
+	movups 32(%rsi),%xmm2
+	movups 48(%rsi),%xmm3
+	movups 64(%rsi),%xmm4
+	movups 80(%rsi),%xmm5
+	movups 96(%rsi),%xmm6
+	movups 112(%rsi),%xmm7
+	movups -128(%rsi,%rdx),%xmm8
+	movups -112(%rsi,%rdx),%xmm9
+	movups -96(%rsi,%rdx),%xmm10
+	movups -80(%rsi,%rdx),%xmm11
+	movups -64(%rsi,%rdx),%xmm12
+	movups -48(%rsi,%rdx),%xmm13
+	movups -32(%rsi,%rdx),%xmm14
+	movups -16(%rsi,%rdx),%xmm15
+	movups %xmm0,(%rdi)
+	movups %xmm1,16(%rdi)
+	movups %xmm2,32(%rdi)
+	movups %xmm3,48(%rdi)
+	movups %xmm4,64(%rdi)
+	movups %xmm5,80(%rdi)
+	movups %xmm6,96(%rdi)
+	movups %xmm7,112(%rdi)
+	movups %xmm8,-128(%rdi,%rdx)
+	movups %xmm9,-112(%rdi,%rdx)
+	movups %xmm10,-96(%rdi,%rdx)
+	movups %xmm11,-80(%rdi,%rdx)
+	movups %xmm12,-64(%rdi,%rdx)
+	movups %xmm13,-48(%rdi,%rdx)
+	movups %xmm14,-32(%rdi,%rdx)
+	movups %xmm15,-16(%rdi,%rdx)
+	ret
+
+1:	cmp __memcpy_nt_threshold(%rip),%rdx
+	jae 3f
+	cmp __memcpy_rep_threshold(%rip),%rdx
+	jae 4f
+
+	# the first 16 and last 64 bytes are copied from registers
+	# loaded up front; the loop stores to 16-aligned destinations
+	movups (%rsi),%xmm8
+	movups -64(%rsi,%rdx),%xmm4
+	movups -48(%rsi,%rdx),%xmm5
+	movups -32(%rsi,%rdx),%xmm6
+	movups -16(%rsi,%rdx),%xmm7
+	lea -64(%rdi,%rdx),%r9
+	lea 16(%rdi),%rcx
+	and $-16,%rcx
+	sub %rdi,%rcx
+	add %rcx,%rsi
+	add %rcx,%rdi
+2:	movups (%rsi),%xmm0
+	movups 16(%rsi),%xmm1
+	movups 32(%rsi),%xmm2
+	movups 48(%rsi),%xmm3
+	movaps %xmm0,(%rdi)
+	movaps %xmm1,16(%rdi)
+	movaps %xmm2,32(%rdi)
+	movaps %xmm3,48(%rdi)
+	add $64,%rsi
+	add $64,%rdi
+	cmp %r9,%rdi
+	jb 2b
+	movups %xmm4,(%r9)
+	movups %xmm5,16(%r9)
+	movups %xmm6,32(%r9)
+	movups %xmm7,48(%r9)
+	movups %xmm8,(%rax)
+	ret
+
+	# same shape with streaming stores, for copies that would
+	# otherwise flush the whole cache
+3:	movups (%rsi),%xmm8
+	movups -64(%rsi,%rdx),%xmm4
+	movups -48(%rsi,%rdx),%xmm5
+	movups -32(%rsi,%rdx),%xmm6
+	movups -16(%rsi,%rdx),%xmm7
+	lea -64(%rdi,%rdx),%r9
+	lea 16(%rdi),%rcx
+	and $-16,%rcx
+	sub %rdi,%rcx
+	add %rcx,%rsi
+	add %rcx,%rdi
+2:	prefetcht0 512(%rsi)
+	movups (%rsi),%xmm0
+	movups 16(%rsi),%xmm1
+	movups 32(%rsi),%xmm2
+	movups 48(%rsi),%xmm3
+	movntdq %xmm0,(%rdi)
+	movntdq %xmm1,16(%rdi)
+	movntdq %xmm2,32(%rdi)
+	movntdq %xmm3,48(%rdi)
+	add $64,%rsi
+	add $64,%rdi
+	cmp %r9,%rdi
+	jb 2b
+	sfence
+	movups %xmm4,(%r9)
+	movups %xmm5,16(%r9)
+	movups %xmm6,32(%r9)
+	movups %xmm7,48(%r9)
+	movups %xmm8,(%rax)
+	ret
+
+4:	mov %rdx,%rcx
+	rep
+	movsb
+	ret
+
+5:	cmp $8,%edx
+	jb 1f
+	mov (%rsi),%rcx
+	mov -8(%rsi,%rdx),%r8
+	mov %rcx,(%rdi)
+	mov %r8,-8(%rdi,%rdx)
+	ret
+1:	cmp $4,%edx
+	jb 1f
+	mov (%rsi),%ecx
+	mov -4(%rsi,%rdx),%r8d
+	mov %ecx,(%rdi)
+	mov %r8d,-4(%rdi,%rdx)
+	ret
+1:	cmp $2,%edx
+	jb 1f
+	movzwl (%rsi),%ecx
+	movzwl -2(%rsi,%rdx),%r8d
+	mov %cx,(%rdi)
+	mov %r8w,-2(%rdi,%rdx)
+	ret
+1:	test %edx,%edx
+	jz 1f
+	movzbl (%rsi),%ecx
+	mov %cl,(%rdi)
+1:	ret
@@ -0,0 +1,26 @@
+#define _GNU_SOURCE
+#include <string.h>
+
+hidden void *__memmem_generic(const void *, size_t, const void *, size_t);
+hidden const unsigned char *__memmem_cand(const unsigned char *, const unsigned char *, const unsigned char *, size_t);
+
+#define memmem __memmem_generic
+#include "../memmem.c"
+#undef memmem
+
+/* Prefiltered as in strstr, with the same fallback to Two-Way. */
+
+void *memmem(const void *h0, size_t k, const void *n0, size_t l)
+{
+	const unsigned char *h = h0, *n = n0, *z = h+k, *p;
+	size_t work = 0;
+
+	if (l < 2 || k < l) return __memmem_generic(h0, k, n0, l);
+
+	for (p=h; (p = __memmem_cand(p, z, n, l)); p++) {
+		if (!memcmp(p+1, n+1, l-2)) return (void *)p;
+		if ((work += l) > 2*(size_t)(p-h) + 1024)
+			return twoway_memmem(p+1, z, n, l);
+	}
+	return 0;
+}
@@ -0,0 +1,25 @@
+#include <string.h>
+#include "cpu.h"
+
+hidden void *__memmove_sse2(void *, const void *, size_t);
+hidden void *__memmove_avx2(void *, const void *, size_t);
+hidden void __memcpy_tune(void);
+
+static void *resolve(void *, const void *, size_t);
+static void *(*impl)(void *, const void *, size_t) = resolve;
+
+static void *resolve(void *d, const void *s, size_t n)
+{
+	void *(*f)(void *, const void *, size_t) = __memmove_sse2;
+	if (CPU_HAS(CPU_AVX2)) f = __memmove_avx2;
+	if (libc.cpu_ready) {
+		__memcpy_tune();
+		impl = f;
+	}
+	return f(d, s, n);
+}
+
+void *memmove(void *d, const void *s, size_t n)
+{
+	return impl(d, s, n);
+}
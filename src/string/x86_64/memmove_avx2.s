@@ -0,0 +1,47 @@
+.global __memmove_avx2
+.hidden __memmove_avx2
+.hidden __memcpy_avx2
+.type __memmove_avx2,@function
+__memmove_avx2:
+	mov %rdi,%rax
+	sub %rsi,%rax
+	cmp %rdx,%rax
+	jae __memcpy_avx2
+	cmp $256,%rdx
+	jbe __memcpy_avx2
+
+	# destination overlaps the end of the source: copy downwards,
+	# keeping the first 128 and last 32 bytes in registers
+	mov %rdi,%rax
+	vmovdqu (%rsi),%ymm4
+	vmovdqu 32(%rsi),%ymm5
+	vmovdqu 64(%rsi),%ymm6
+	vmovdqu 96(%rsi),%ymm7
+	vmovdqu -32(%rsi,%rdx),%ymm8
+	lea -32(%rdi,%rdx),%r10
+	lea 128(%rdi),%r9
+	lea (%rdi,%rdx),%rcx
+	and $31,%ecx
+	lea (%rdi,%rdx),%rdi
+	sub %rcx,%rdi
+	lea (%rsi,%rdx),%rsi
+	sub %rcx,%rsi
+1:	add $-128,%rsi
+	add $-128,%rdi
+	vmovdqu 96(%rsi),%ymm3
+	vmovdqu 64(%rsi),%ymm2
+	vmovdqu 32(%rsi),%ymm1
+	vmovdqu (%rsi),%ymm0
+	vmovdqa %ymm3,96(%rdi)
+	vmovdqa %ymm2,64(%rdi)
+	vmovdqa %ymm1,32(%rdi)
+	vmovdqa %ymm0,(%rdi)
+	cmp %r9,%rdi
+	ja 1b
+	vmovdqu %ymm4,(%rax)
+	vmovdqu %ymm5,32(%rax)
+	vmovdqu %ymm6,64(%rax)
+	vmovdqu %ymm7,96(%rax)
+	vmovdqu %ymm8,(%r10)
+	vzeroupper
+	ret
@@ -0,0 +1,46 @@
+.global __memmove_sse2
+.hidden __memmove_sse2
+.hidden __memcpy_sse2
+.type __memmove_sse2,@function
+__memmove_sse2:
+	mov %rdi,%rax
+	sub %rsi,%rax
+	cmp %rdx,%rax
+	jae __memcpy_sse2
+	cmp $256,%rdx
+	jbe __memcpy_sse2
+
+	# destination overlaps the end of the source: copy downwards,
+	# keeping the first 64 and last 16 bytes in registers
+	mov %rdi,%rax
+	movups (%rsi),%xmm4
+	movups 16(%rsi),%xmm5
+	movups 32(%rsi),%xmm6
+	movups 48(%rsi),%xmm7
+	movups -16(%rsi,%rdx),%xmm8
+	lea -16(%rdi,%rdx),%r10
+	lea 64(%rdi),%r9
+	lea (%rdi,%rdx),%rcx
+	and $15,%ecx
+	lea (%rdi,%rdx),%rdi
+	sub %rcx,%rdi
+	lea (%rsi,%rdx),%rsi
+	sub %rcx,%rsi
+1:	sub $64,%rsi
+	sub $64,%rdi
+	movups 48(%rsi),%xmm3
+	movups 32(%rsi),%xmm2
+	movups 16(%rsi),%xmm1
+	movups (%rsi),%xmm0
+	movaps %xmm3,48(%rdi)
+	movaps %xmm2,32(%rdi)
+	movaps %xmm1,16(%rdi)
+	movaps %xmm0,(%rdi)
+	cmp %r9,%rdi
+	ja 1b
+	movups %xmm4,(%rax)
+	movups %xmm5,16(%rax)
+	movups %xmm6,32(%rax)
+	movups %xmm7,48(%rax)
+	movups %xmm8,(%r10)
+	ret
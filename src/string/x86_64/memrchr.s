@@ -0,0 +1,43 @@
+.global __memrchr
+.hidden __memrchr
+.weak memrchr
+.type __memrchr,@function
+.type memrchr,@function
+__memrchr:
+memrchr:
+	test %rdx,%rdx
+	jz 3f
+	movd %esi,%xmm0
+	punpcklbw %xmm0,%xmm0
+	punpcklwd %xmm0,%xmm0
+	pshufd $0,%xmm0,%xmm0
+	lea -1(%rdi,%rdx),%rax
+	mov %eax,%ecx
+	and $-16,%rax
+	and $15,%ecx
+	mov $2,%edx
+	shl %cl,%edx
+	dec %edx
+	movdqa (%rax),%xmm1
+	pcmpeqb %xmm0,%xmm1
+	pmovmskb %xmm1,%r8d
+	and %edx,%r8d
+	jnz 2f
+
+1:	cmp %rdi,%rax
+	jbe 3f
+	sub $16,%rax
+	movdqa (%rax),%xmm1
+	pcmpeqb %xmm0,%xmm1
+	pmovmskb %xmm1,%r8d
+	test %r8d,%r8d
+	jz 1b
+
+2:	bsr %r8d,%r8d
+	add %r8,%rax
+	cmp %rdi,%rax
+	jb 3f
+	ret
+
+3:	xor %eax,%eax
+	ret
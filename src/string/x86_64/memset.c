@@ -0,0 +1,32 @@
+#include <string.h>
+#include <stdint.h>
+#include "cpu.h"
+
+hidden void *__memset_sse2(void *, int, size_t);
+hidden void *__memset_avx2(void *, int, size_t);
+
+/* As for memcpy: rep stosb on ERMS CPUs from the first threshold,
+ * and streaming stores for clears larger than the outermost cache. */
+
+hidden size_t __memset_rep_threshold = SIZE_MAX;
+hidden size_t __memset_nt_threshold = SIZE_MAX;
+
+static void *resolve(void *, int, size_t);
+static void *(*impl)(void *, int, size_t) = resolve;
+
+static void *resolve(void *d, int c, size_t n)
+{
+	void *(*f)(void *, int, size_t) = __memset_sse2;
+	if (CPU_HAS(CPU_AVX2)) f = __memset_avx2;
+	if (libc.cpu_ready) {
+		if (CPU_HAS(CPU_ERMS)) __memset_rep_threshold = 2048;
+		if (libc.cache_size) __memset_nt_threshold = libc.cache_size;
+		impl = f;
+	}
+	return f(d, c, n);
+}
+
+void *memset(void *d, int c, size_t n)
+{
+	return impl(d, c, n);
+}
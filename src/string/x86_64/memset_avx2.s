@@ -0,0 +1,109 @@
+.global __memset_avx2
+.hidden __memset_avx2
+.hidden __memset_rep_threshold
+.hidden __memset_nt_threshold
+.type __memset_avx2,@function
+__memset_avx2:
+	movzbl %sil,%ecx
+	mov $0x101010101010101,%r8
+	imul %rcx,%r8
+	mov %rdi,%rax
+	cmp $16,%rdx
+	jb 5f
+	vmovd %esi,%xmm0
+	vpbroadcastb %xmm0,%ymm0
+	cmp $32,%rdx
+	ja 1f
+	vmovdqu %xmm0,(%rdi)
+	vmovdqu %xmm0,-16(%rdi,%rdx)
+	vzeroupper
+	ret
+
+1:	cmp $64,%rdx
+	ja 1f
+	vmovdqu %ymm0,(%rdi)
+	vmovdqu %ymm0,-32(%rdi,%rdx)
+	vzeroupper
+	ret
+
+1:	cmp $128,%rdx
+	ja 1f
+	vmovdqu %ymm0,(%rdi)
+	vmovdqu %ymm0,32(%rdi)
+	vmovdqu %ymm0,-64(%rdi,%rdx)
+	vmovdqu %ymm0,-32(%rdi,%rdx)
+	vzeroupper
+	ret
+
+1:	cmp __memset_nt_threshold(%rip),%rdx
+	jae 3f
+	cmp __memset_rep_threshold(%rip),%rdx
+	jae 4f
+
+	vmovdqu %ymm0,(%rdi)
+	lea -128(%rdi,%rdx),%r9
+	add $32,%rdi
+	and $-32,%rdi
+	cmp %r9,%rdi
+	jae 6f
+2:	vmovdqa %ymm0,(%rdi)
+	vmovdqa %ymm0,32(%rdi)
+	vmovdqa %ymm0,64(%rdi)
+	vmovdqa %ymm0,96(%rdi)
+	sub $-128,%rdi
+	cmp %r9,%rdi
+	jb 2b
+6:	vmovdqu %ymm0,(%r9)
+	vmovdqu %ymm0,32(%r9)
+	vmovdqu %ymm0,64(%r9)
+	vmovdqu %ymm0,96(%r9)
+	vzeroupper
+	ret
+
+3:	vmovdqu %ymm0,(%rdi)
+	lea -128(%rdi,%rdx),%r9
+	add $32,%rdi
+	and $-32,%rdi
+2:	vmovntdq %ymm0,(%rdi)
+	vmovntdq %ymm0,32(%rdi)
+	vmovntdq %ymm0,64(%rdi)
+	vmovntdq %ymm0,96(%rdi)
+	sub $-128,%rdi
+	cmp %r9,%rdi
+	jb 2b
+	sfence
+	vmovdqu %ymm0,(%r9)
+	vmovdqu %ymm0,32(%r9)
+	vmovdqu %ymm0,64(%r9)
+	vmovdqu %ymm0,96(%r9)
+	vzeroupper
+	ret
+
+4:	vzeroupper
+	mov %rdx,%rcx
+	mov %rdi,%r9
+	mov %esi,%eax
+	rep
+	stosb
+	mov %r9,%rax
+	ret
+
+5:	cmp $8,%edx
+	jb 1f
+	mov %r8,(%rdi)
+	mov %r8,-8(%rdi,%rdx)
+	ret
+1:	cmp $4,%edx
+	jb 1f
+	mov %r8d,(%rdi)
+	mov %r8d,-4(%rdi,%rdx)
+	ret
+1:	cmp $2,%edx
+	jb 1f
+	mov %r8w,(%rdi)
+	mov %r8w,-2(%rdi,%rdx)
+	ret
+1:	test %edx,%edx
+	jz 1f
+	mov %r8b,(%rdi)
+1:	ret
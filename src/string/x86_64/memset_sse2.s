@@ -0,0 +1,110 @@
+.global __memset_sse2
+.hidden __memset_sse2
+.hidden __memset_rep_threshold
+.hidden __memset_nt_threshold
+.type __memset_sse2,@function
+__memset_sse2:
+	movzbl %sil,%ecx
+	mov $0x101010101010101,%r8
+	imul %rcx,%r8
+	mov %rdi,%rax
+	cmp $16,%rdx
+	jb 5f
+	movq %r8,%xmm0
+	punpcklqdq %xmm0,%xmm0
+	cmp $32,%rdx
+	ja 1f
+	movups %xmm0,(%rdi)
+	movups %xmm0,-16(%rdi,%rdx)
+	ret
+
+1:	cmp $64,%rdx
+	ja 1f
+	movups %xmm0,(%rdi)
+	movups %xmm0,16(%rdi)
+	movups %xmm0,-32(%rdi,%rdx)
+	movups %xmm0,-16(%rdi,%rdx)
+	ret
+
+1:	cmp $128,%rdx
+	ja 1f
+	movups %xmm0,(%rdi)
+	movups %xmm0,16(%rdi)
+	movups %xmm0,32(%rdi)
+	movups %xmm0,48(%rdi)
+	movups %xmm0,-64(%rdi,%rdx)
+	movups %xmm0,-48(%rdi,%rdx)
+	movups %xmm0,-32(%rdi,%rdx)
+	movups %xmm0,-16(%rdi,%rdx)
+	ret
+
+1:	cmp __memset_nt_threshold(%rip),%rdx
+	jae 3f
+	cmp __memset_rep_threshold(%rip),%rdx
+	jae 4f
+
+	# unaligned head and tail, aligned stores in between
+	movups %xmm0,(%rdi)
+	lea -64(%rdi,%rdx),%r9
+	add $16,%rdi
+	and $-16,%rdi
+2:	movaps %xmm0,(%rdi)
+	movaps %xmm0,16(%rdi)
+	movaps %xmm0,32(%rdi)
+	movaps %xmm0,48(%rdi)
+	add $64,%rdi
+	cmp %r9,%rdi
+	jb 2b
+	movups %xmm0,(%r9)
+	movups %xmm0,16(%r9)
+	movups %xmm0,32(%r9)
+	movups %xmm0,48(%r9)
+	ret
+
+	# streaming stores, so that clearing a huge buffer does not
+	# evict the rest of the cache
+3:	movups %xmm0,(%rdi)
+	lea -64(%rdi,%rdx),%r9
+	add $16,%rdi
+	and $-16,%rdi
+2:	movntdq %xmm0,(%rdi)
+	movntdq %xmm0,16(%rdi)
+	movntdq %xmm0,32(%rdi)
+	movntdq %xmm0,48(%rdi)
+	add $64,%rdi
+	cmp %r9,%rdi
+	jb 2b
+	sfence
+	movups %xmm0,(%r9)
+	movups %xmm0,16(%r9)
+	movups %xmm0,32(%r9)
+	movups %xmm0,48(%r9)
+	ret
+
+4:	mov %rdx,%rcx
+	mov %rdi,%r9
+	mov %esi,%eax
+	rep
+	stosb
+	mov %r9,%rax
+	ret
+
+5:	cmp $8,%edx
+	jb 1f
+	mov %r8,(%rdi)
+	mov %r8,-8(%rdi,%rdx)
+	ret
+1:	cmp $4,%edx
+	jb 1f
+	mov %r8d,(%rdi)
+	mov %r8d,-4(%rdi,%rdx)
+	ret
+1:	cmp $2,%edx
+	jb 1f
+	mov %r8w,(%rdi)
+	mov %r8w,-2(%rdi,%rdx)
+	ret
+1:	test %edx,%edx
+	jz 1f
+	mov %r8b,(%rdi)
+1:	ret
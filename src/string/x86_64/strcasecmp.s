@@ -0,0 +1,80 @@
+.global strcasecmp
+.global __strcasecmp_l
+.weak strcasecmp_l
+.type strcasecmp,@function
+.type __strcasecmp_l,@function
+.type strcasecmp_l,@function
+strcasecmp:
+__strcasecmp_l:
+strcasecmp_l:
+	mov $0x3f3f3f3f,%eax
+	movd %eax,%xmm4
+	pshufd $0,%xmm4,%xmm4
+	mov $0x9a9a9a9a,%eax
+	movd %eax,%xmm5
+	pshufd $0,%xmm5,%xmm5
+	mov $0x20202020,%eax
+	movd %eax,%xmm6
+	pshufd $0,%xmm6,%xmm6
+	pxor %xmm2,%xmm2
+
+	# as strcmp, comparing bytes folded to lower case. a byte
+	# b is in A-Z when b+0x3f, as a signed byte, is below -102
+1:	mov %edi,%eax
+	mov %esi,%ecx
+	and $4095,%eax
+	and $4095,%ecx
+	cmp $4080,%eax
+	ja 3f
+	cmp $4080,%ecx
+	ja 3f
+	movdqu (%rdi),%xmm0
+	movdqu (%rsi),%xmm1
+	movdqa %xmm0,%xmm3
+	movdqa %xmm1,%xmm7
+	paddb %xmm4,%xmm3
+	paddb %xmm4,%xmm7
+	movdqa %xmm5,%xmm8
+	movdqa %xmm5,%xmm9
+	pcmpgtb %xmm3,%xmm8
+	pcmpgtb %xmm7,%xmm9
+	pand %xmm6,%xmm8
+	pand %xmm6,%xmm9
+	por %xmm8,%xmm0
+	por %xmm9,%xmm1
+	movdqa %xmm0,%xmm3
+	pcmpeqb %xmm1,%xmm0
+	pcmpeqb %xmm2,%xmm3
+	pmovmskb %xmm0,%eax
+	pmovmskb %xmm3,%ecx
+	xor $0xffff,%eax
+	or %ecx,%eax
+	jnz 2f
+	add $16,%rdi
+	add $16,%rsi
+	jmp 1b
+
+2:	bsf %eax,%ecx
+	add %rcx,%rdi
+	add %rcx,%rsi
+
+3:	movzbl (%rdi),%eax
+	movzbl (%rsi),%edx
+	lea -65(%rax),%ecx
+	cmp $26,%ecx
+	sbb %ecx,%ecx
+	and $32,%ecx
+	or %ecx,%eax
+	lea -65(%rdx),%ecx
+	cmp $26,%ecx
+	sbb %ecx,%ecx
+	and $32,%ecx
+	or %ecx,%edx
+	sub %edx,%eax
+	jnz 4f
+	test %edx,%edx
+	jz 4f
+	inc %rdi
+	inc %rsi
+	jmp 1b
+4:	ret
@@ -0,0 +1,41 @@
+.global __strchrnul
+.hidden __strchrnul
+.weak strchrnul
+.type __strchrnul,@function
+.type strchrnul,@function
+__strchrnul:
+strchrnul:
+	movd %esi,%xmm0
+	punpcklbw %xmm0,%xmm0
+	punpcklwd %xmm0,%xmm0
+	pshufd $0,%xmm0,%xmm0
+	pxor %xmm1,%xmm1
+	mov %rdi,%rax
+	mov %edi,%ecx
+	and $-16,%rax
+	and $15,%ecx
+	movdqa (%rax),%xmm2
+	movdqa %xmm2,%xmm3
+	pcmpeqb %xmm0,%xmm2
+	pcmpeqb %xmm1,%xmm3
+	por %xmm3,%xmm2
+	pmovmskb %xmm2,%edx
+	shr %cl,%edx
+	test %edx,%edx
+	jz 1f
+	bsf %edx,%edx
+	lea (%rdi,%rdx),%rax
+	ret
+
+1:	add $16,%rax
+	movdqa (%rax),%xmm2
+	movdqa %xmm2,%xmm3
+	pcmpeqb %xmm0,%xmm2
+	pcmpeqb %xmm1,%xmm3
+	por %xmm3,%xmm2
+	pmovmskb %xmm2,%edx
+	test %edx,%edx
+	jz 1b
+	bsf %edx,%edx
+	add %rdx,%rax
+	ret
@@ -0,0 +1,45 @@
+.global strcmp
+.type strcmp,@function
+strcmp:
+	pxor %xmm2,%xmm2
+
+	# unaligned 16-byte compares, except within 16 bytes
+	# of the end of a page, where one byte is compared
+1:	mov %edi,%eax
+	mov %esi,%ecx
+	and $4095,%eax
+	and $4095,%ecx
+	cmp $4080,%eax
+	ja 3f
+	cmp $4080,%ecx
+	ja 3f
+	movdqu (%rdi),%xmm0
+	movdqu (%rsi),%xmm1
+	movdqa %xmm0,%xmm3
+	pcmpeqb %xmm1,%xmm0
+	pcmpeqb %xmm2,%xmm3
+	pmovmskb %xmm0,%eax
+	pmovmskb %xmm3,%ecx
+	xor $0xffff,%eax
+	or %ecx,%eax
+	jnz 2f
+	add $16,%rdi
+	add $16,%rsi
+	jmp 1b
+
+2:	bsf %eax,%ecx
+	movzbl (%rdi,%rcx),%eax
+	movzbl (%rsi,%rcx),%edx
+	sub %edx,%eax
+	ret
+
+3:	movzbl (%rdi),%eax
+	movzbl (%rsi),%edx
+	sub %edx,%eax
+	jnz 4f
+	test %edx,%edx
+	jz 4f
+	inc %rdi
+	inc %rsi
+	jmp 1b
+4:	ret
@@ -0,0 +1,34 @@
+#include <string.h>
+#include <stdint.h>
+#include "cpu.h"
+
+hidden size_t __strcspn_generic(const char *, const char *);
+hidden size_t __span4(const char *, uint32_t, unsigned);
+hidden size_t __span_tbl(const char *, const unsigned char *, unsigned);
+
+#define strcspn __strcspn_generic
+#include "../strcspn.c"
+#undef strcspn
+
+/* Up to three reject bytes are compared directly, the fourth slot
+ * holding the null so the scan stops at the end of the string.
+ * Larger sets need the SSSE3 nibble table, which includes the null
+ * for the same reason. */
+
+size_t strcspn(const char *s, const char *c)
+{
+	const unsigned char *u = (void *)c;
+	unsigned char tbl[32] = { 1 };
+	size_t i;
+
+	if (!c[0] || !c[1]) return __strchrnul(s, *c)-s;
+	for (i=2; i<4 && u[i]; i++);
+	if (i<4) {
+		uint32_t set = 0;
+		while (i--) set = set<<8 | u[i];
+		return __span4(s, set, 0);
+	}
+	if (!CPU_HAS(CPU_SSSE3)) return __strcspn_generic(s, c);
+	for (; *u; u++) tbl[(*u&15) | (*u&128)>>3] |= 1<<(*u>>4&7);
+	return __span_tbl(s, tbl, 0);
+}
@@ -0,0 +1,21 @@
+#include <string.h>
+#include "cpu.h"
+
+hidden size_t __strlen_sse2(const char *);
+hidden size_t __strlen_avx2(const char *);
+
+static size_t resolve(const char *);
+static size_t (*impl)(const char *) = resolve;
+
+static size_t resolve(const char *s)
+{
+	size_t (*f)(const char *) = __strlen_sse2;
+	if (CPU_HAS(CPU_AVX2)) f = __strlen_avx2;
+	if (libc.cpu_ready) impl = f;
+	return f(s);
+}
+
+size_t strlen(const char *s)
+{
+	return impl(s);
+}
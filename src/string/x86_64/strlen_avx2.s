@@ -0,0 +1,50 @@
+.global __strlen_avx2
+.hidden __strlen_avx2
+.type __strlen_avx2,@function
+__strlen_avx2:
+	mov %rdi,%rax
+	mov %edi,%ecx
+	vpxor %xmm0,%xmm0,%xmm0
+	and $-32,%rax
+	and $31,%ecx
+	vpcmpeqb (%rax),%ymm0,%ymm1
+	vpmovmskb %ymm1,%edx
+	shr %cl,%edx
+	test %edx,%edx
+	jz 1f
+	bsf %edx,%eax
+	vzeroupper
+	ret
+
+1:	add $32,%rax
+	test $127,%al
+	jz 2f
+	vpcmpeqb (%rax),%ymm0,%ymm1
+	vpmovmskb %ymm1,%edx
+	test %edx,%edx
+	jz 1b
+	jmp 4f
+
+2:	vmovdqa (%rax),%ymm1
+	vpminub 32(%rax),%ymm1,%ymm1
+	vpminub 64(%rax),%ymm1,%ymm1
+	vpminub 96(%rax),%ymm1,%ymm1
+	vpcmpeqb %ymm0,%ymm1,%ymm1
+	vpmovmskb %ymm1,%edx
+	test %edx,%edx
+	jnz 3f
+	sub $-128,%rax
+	jmp 2b
+
+3:	vpcmpeqb (%rax),%ymm0,%ymm1
+	vpmovmskb %ymm1,%edx
+	test %edx,%edx
+	jnz 4f
+	add $32,%rax
+	jmp 3b
+
+4:	bsf %edx,%edx
+	add %rdx,%rax
+	sub %rdi,%rax
+	vzeroupper
+	ret
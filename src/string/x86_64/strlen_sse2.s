@@ -0,0 +1,51 @@
+.global __strlen_sse2
+.hidden __strlen_sse2
+.type __strlen_sse2,@function
+__strlen_sse2:
+	mov %rdi,%rax
+	mov %edi,%ecx
+	pxor %xmm0,%xmm0
+	and $-16,%rax
+	and $15,%ecx
+	movdqa (%rax),%xmm1
+	pcmpeqb %xmm0,%xmm1
+	pmovmskb %xmm1,%edx
+	shr %cl,%edx
+	test %edx,%edx
+	jz 1f
+	bsf %edx,%eax
+	ret
+
+1:	add $16,%rax
+	test $63,%al
+	jz 2f
+	movdqa (%rax),%xmm1
+	pcmpeqb %xmm0,%xmm1
+	pmovmskb %xmm1,%edx
+	test %edx,%edx
+	jz 1b
+	jmp 4f
+
+2:	movdqa (%rax),%xmm1
+	pminub 16(%rax),%xmm1
+	pminub 32(%rax),%xmm1
+	pminub 48(%rax),%xmm1
+	pcmpeqb %xmm0,%xmm1
+	pmovmskb %xmm1,%edx
+	test %edx,%edx
+	jnz 3f
+	add $64,%rax
+	jmp 2b
+
+3:	movdqa (%rax),%xmm1
+	pcmpeqb %xmm0,%xmm1
+	pmovmskb %xmm1,%edx
+	test %edx,%edx
+	jnz 4f
+	add $16,%rax
+	jmp 3b
+
+4:	bsf %edx,%edx
+	add %rdx,%rax
+	sub %rdi,%rax
+	ret
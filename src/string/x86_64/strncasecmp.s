@@ -0,0 +1,91 @@
+.global strncasecmp
+.global __strncasecmp_l
+.weak strncasecmp_l
+.type strncasecmp,@function
+.type __strncasecmp_l,@function
+.type strncasecmp_l,@function
+strncasecmp:
+__strncasecmp_l:
+strncasecmp_l:
+	xor %eax,%eax
+	test %rdx,%rdx
+	jz 4f
+	mov $0x3f3f3f3f,%eax
+	movd %eax,%xmm4
+	pshufd $0,%xmm4,%xmm4
+	mov $0x9a9a9a9a,%eax
+	movd %eax,%xmm5
+	pshufd $0,%xmm5,%xmm5
+	mov $0x20202020,%eax
+	movd %eax,%xmm6
+	pshufd $0,%xmm6,%xmm6
+	pxor %xmm2,%xmm2
+
+	# as strcasecmp, with rdx bytes left to compare
+1:	mov %edi,%eax
+	mov %esi,%ecx
+	and $4095,%eax
+	and $4095,%ecx
+	cmp $4080,%eax
+	ja 3f
+	cmp $4080,%ecx
+	ja 3f
+	movdqu (%rdi),%xmm0
+	movdqu (%rsi),%xmm1
+	movdqa %xmm0,%xmm3
+	movdqa %xmm1,%xmm7
+	paddb %xmm4,%xmm3
+	paddb %xmm4,%xmm7
+	movdqa %xmm5,%xmm8
+	movdqa %xmm5,%xmm9
+	pcmpgtb %xmm3,%xmm8
+	pcmpgtb %xmm7,%xmm9
+	pand %xmm6,%xmm8
+	pand %xmm6,%xmm9
+	por %xmm8,%xmm0
+	por %xmm9,%xmm1
+	movdqa %xmm0,%xmm3
+	pcmpeqb %xmm1,%xmm0
+	pcmpeqb %xmm2,%xmm3
+	pmovmskb %xmm0,%eax
+	pmovmskb %xmm3,%ecx
+	xor $0xffff,%eax
+	or %ecx,%eax
+	jnz 2f
+	xor %eax,%eax
+	cmp $16,%rdx
+	jbe 4f
+	add $16,%rdi
+	add $16,%rsi
+	sub $16,%rdx
+	jmp 1b
+
+2:	bsf %eax,%ecx
+	xor %eax,%eax
+	cmp %rdx,%rcx
+	jae 4f
+	add %rcx,%rdi
+	add %rcx,%rsi
+	mov $1,%edx
+
+3:	movzbl (%rdi),%eax
+	movzbl (%rsi),%ecx
+	lea -65(%rax),%r8d
+	cmp $26,%r8d
+	sbb %r8d,%r8d
+	and $32,%r8d
+	or %r8d,%eax
+	lea -65(%rcx),%r8d
+	cmp $26,%r8d
+	sbb %r8d,%r8d
+	and $32,%r8d
+	or %r8d,%ecx
+	sub %ecx,%eax
+	jnz 4f
+	test %ecx,%ecx
+	jz 4f
+	inc %rdi
+	inc %rsi
+	dec %rdx
+	jnz 1b
+4:	ret
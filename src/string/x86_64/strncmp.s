@@ -0,0 +1,55 @@
+.global strncmp
+.type strncmp,@function
+strncmp:
+	xor %eax,%eax
+	test %rdx,%rdx
+	jz 4f
+	pxor %xmm2,%xmm2
+
+	# as strcmp, with rdx bytes left to compare
+1:	mov %edi,%eax
+	mov %esi,%ecx
+	and $4095,%eax
+	and $4095,%ecx
+	cmp $4080,%eax
+	ja 3f
+	cmp $4080,%ecx
+	ja 3f
+	movdqu (%rdi),%xmm0
+	movdqu (%rsi),%xmm1
+	movdqa %xmm0,%xmm3
+	pcmpeqb %xmm1,%xmm0
+	pcmpeqb %xmm2,%xmm3
+	pmovmskb %xmm0,%eax
+	pmovmskb %xmm3,%ecx
+	xor $0xffff,%eax
+	or %ecx,%eax
+	jnz 2f
+	xor %eax,%eax
+	cmp $16,%rdx
+	jbe 4f
+	add $16,%rdi
+	add $16,%rsi
+	sub $16,%rdx
+	jmp 1b
+
+2:	bsf %eax,%ecx
+	xor %eax,%eax
+	cmp %rdx,%rcx
+	jae 4f
+	movzbl (%rdi,%rcx),%eax
+	movzbl (%rsi,%rcx),%edx
+	sub %edx,%eax
+	ret
+
+3:	movzbl (%rdi),%eax
+	movzbl (%rsi),%ecx
+	sub %ecx,%eax
+	jnz 4f
+	test %ecx,%ecx
+	jz 4f
+	inc %rdi
+	inc %rsi
+	dec %rdx
+	jnz 1b
+4:	ret
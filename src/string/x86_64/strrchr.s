@@ -0,0 +1,51 @@
+.global strrchr
+.type strrchr,@function
+strrchr:
+	movd %esi,%xmm0
+	punpcklbw %xmm0,%xmm0
+	punpcklwd %xmm0,%xmm0
+	pshufd $0,%xmm0,%xmm0
+	pxor %xmm1,%xmm1
+	mov %rdi,%rax
+	mov %edi,%ecx
+	and $-16,%rax
+	and $15,%ecx
+	mov $-1,%r10d
+	shl %cl,%r10d
+	xor %r9d,%r9d
+
+	# r9d/r11 hold the match mask and block of the last
+	# block seen with a match before the terminator
+1:	movdqa (%rax),%xmm2
+	movdqa %xmm2,%xmm3
+	pcmpeqb %xmm0,%xmm2
+	pcmpeqb %xmm1,%xmm3
+	pmovmskb %xmm2,%edx
+	pmovmskb %xmm3,%r8d
+	and %r10d,%edx
+	and %r10d,%r8d
+	jnz 2f
+	test %edx,%edx
+	jz 3f
+	mov %edx,%r9d
+	mov %rax,%r11
+3:	add $16,%rax
+	or $-1,%r10d
+	jmp 1b
+
+2:	lea -1(%r8),%ecx
+	xor %r8d,%ecx
+	and %ecx,%edx
+	jz 4f
+	bsr %edx,%edx
+	add %rdx,%rax
+	ret
+
+4:	test %r9d,%r9d
+	jz 5f
+	bsr %r9d,%r9d
+	lea (%r11,%r9),%rax
+	ret
+
+5:	xor %eax,%eax
+	ret
@@ -0,0 +1,32 @@
+#include <string.h>
+#include <stdint.h>
+#include "cpu.h"
+
+hidden size_t __strspn_generic(const char *, const char *);
+hidden size_t __span4(const char *, uint32_t, unsigned);
+hidden size_t __span_tbl(const char *, const unsigned char *, unsigned);
+
+#define strspn __strspn_generic
+#include "../strspn.c"
+#undef strspn
+
+/* As strcspn; short accept sets are padded with their first byte,
+ * and the null, never in the set, ends the scan. */
+
+size_t strspn(const char *s, const char *c)
+{
+	const unsigned char *u = (void *)c;
+	unsigned char tbl[32] = { 0 };
+	size_t i;
+
+	if (!c[0]) return 0;
+	for (i=1; i<4 && u[i]; i++);
+	if (i<4 || !u[4]) {
+		uint32_t set = u[0] * 0x01010101u;
+		while (--i) set = set<<8 | u[i];
+		return __span4(s, set, 0xffff);
+	}
+	if (!CPU_HAS(CPU_SSSE3)) return __strspn_generic(s, c);
+	for (; *u; u++) tbl[(*u&15) | (*u&128)>>3] |= 1<<(*u>>4&7);
+	return __span_tbl(s, tbl, 0xffff);
+}
@@ -0,0 +1,32 @@
+#include <string.h>
+
+hidden char *__strstr_generic(const char *, const char *);
+hidden const unsigned char *__strstr_cand(const unsigned char *, const unsigned char *, size_t);
+
+#define strstr __strstr_generic
+#include "../strstr.c"
+#undef strstr
+
+/* Candidates matching the first and last needle bytes are found 16
+ * positions at a time and then verified. Once verification has cost
+ * more than twice the distance covered, the rest of the search is
+ * left to Two-Way, which keeps the worst case linear. */
+
+char *strstr(const char *h0, const char *n0)
+{
+	const unsigned char *h, *n = (void *)n0, *p;
+	size_t l, work = 0;
+
+	if (!n[0] || !n[1]) return __strstr_generic(h0, n0);
+	h = (void *)strchr(h0, *n);
+	if (!h) return 0;
+	for (l=0; n[l] && h[l]; l++);
+	if (n[l]) return 0;
+
+	for (p=h; (p = __strstr_cand(p, n, l)); p++) {
+		if (!memcmp(p+1, n+1, l-2)) return (char *)p;
+		if ((work += l) > 2*(size_t)(p-h) + 1024)
+			return twoway_strstr(p+1, n);
+	}
+	return 0;
+}
@@ -0,0 +1,39 @@
+.global wcschr
+.type wcschr,@function
+wcschr:
+	movd %esi,%xmm1
+	pshufd $0,%xmm1,%xmm1
+	pxor %xmm2,%xmm2
+	mov %rdi,%rax
+	mov %edi,%ecx
+	and $-16,%rax
+	and $15,%ecx
+	movdqa (%rax),%xmm0
+	movdqa %xmm0,%xmm3
+	pcmpeqd %xmm1,%xmm0
+	pcmpeqd %xmm2,%xmm3
+	por %xmm3,%xmm0
+	pmovmskb %xmm0,%edx
+	shr %cl,%edx
+	shl %cl,%edx
+	test %edx,%edx
+	jnz 2f
+
+1:	add $16,%rax
+	movdqa (%rax),%xmm0
+	movdqa %xmm0,%xmm3
+	pcmpeqd %xmm1,%xmm0
+	pcmpeqd %xmm2,%xmm3
+	por %xmm3,%xmm0
+	pmovmskb %xmm0,%edx
+	test %edx,%edx
+	jz 1b
+
+	# first element equal to c or null; only the former is a match
+2:	bsf %edx,%edx
+	add %rdx,%rax
+	cmp (%rax),%esi
+	jne 1f
+	ret
+1:	xor %eax,%eax
+	ret
@@ -0,0 +1,51 @@
+.global wcscmp
+.type wcscmp,@function
+wcscmp:
+	pxor %xmm2,%xmm2
+
+	# unaligned 4-element compares, except within 16 bytes
+	# of the end of a page, where one element is compared
+1:	mov %edi,%eax
+	mov %esi,%ecx
+	and $4095,%eax
+	and $4095,%ecx
+	cmp $4080,%eax
+	ja 3f
+	cmp $4080,%ecx
+	ja 3f
+	movdqu (%rdi),%xmm0
+	movdqu (%rsi),%xmm1
+	movdqa %xmm0,%xmm3
+	pcmpeqd %xmm1,%xmm0
+	pcmpeqd %xmm2,%xmm3
+	pmovmskb %xmm0,%eax
+	pmovmskb %xmm3,%ecx
+	xor $0xffff,%eax
+	or %ecx,%eax
+	jnz 2f
+	add $16,%rdi
+	add $16,%rsi
+	jmp 1b
+
+2:	bsf %eax,%ecx
+	mov (%rdi,%rcx),%eax
+	mov (%rsi,%rcx),%edx
+	jmp 4f
+
+3:	mov (%rdi),%eax
+	mov (%rsi),%edx
+	cmp %edx,%eax
+	jne 4f
+	test %eax,%eax
+	jz 4f
+	add $4,%rdi
+	add $4,%rsi
+	jmp 1b
+
+4:	cmp %edx,%eax
+	setg %al
+	setl %dl
+	movzbl %al,%eax
+	movzbl %dl,%edx
+	sub %edx,%eax
+	ret
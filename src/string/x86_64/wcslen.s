@@ -0,0 +1,58 @@
+.global wcslen
+.type wcslen,@function
+wcslen:
+	pxor %xmm0,%xmm0
+	mov %rdi,%rax
+	mov %edi,%ecx
+	and $-16,%rax
+	and $15,%ecx
+	movdqa (%rax),%xmm1
+	pcmpeqd %xmm0,%xmm1
+	pmovmskb %xmm1,%edx
+	shr %cl,%edx
+	test %edx,%edx
+	jz 1f
+	bsf %edx,%eax
+	shr $2,%eax
+	ret
+
+1:	add $16,%rax
+	test $63,%al
+	jz 2f
+	movdqa (%rax),%xmm1
+	pcmpeqd %xmm0,%xmm1
+	pmovmskb %xmm1,%edx
+	test %edx,%edx
+	jz 1b
+	jmp 4f
+
+2:	movdqa (%rax),%xmm1
+	movdqa 16(%rax),%xmm2
+	movdqa 32(%rax),%xmm3
+	movdqa 48(%rax),%xmm4
+	pcmpeqd %xmm0,%xmm1
+	pcmpeqd %xmm0,%xmm2
+	pcmpeqd %xmm0,%xmm3
+	pcmpeqd %xmm0,%xmm4
+	por %xmm2,%xmm1
+	por %xmm4,%xmm3
+	por %xmm3,%xmm1
+	pmovmskb %xmm1,%edx
+	test %edx,%edx
+	jnz 3f
+	add $64,%rax
+	jmp 2b
+
+3:	movdqa (%rax),%xmm1
+	pcmpeqd %xmm0,%xmm1
+	pmovmskb %xmm1,%edx
+	test %edx,%edx
+	jnz 4f
+	add $16,%rax
+	jmp 3b
+
+4:	bsf %edx,%edx
+	add %rdx,%rax
+	sub %rdi,%rax
+	shr $2,%rax
+	ret
@@ -0,0 +1,50 @@
+.global wmemchr
+.type wmemchr,@function
+wmemchr:
+	test %rdx,%rdx
+	jz 9f
+	movd %esi,%xmm1
+	pshufd $0,%xmm1,%xmm1
+	mov %rdx,%r8
+	shl $2,%rdx
+	shr $62,%r8
+	jz 1f
+	mov $-1,%rdx
+1:	mov %rdx,%r9
+	mov %rdi,%rax
+	mov %edi,%ecx
+	and $-16,%rax
+	and $15,%ecx
+	add %rcx,%rdx
+	jnc 1f
+	mov $-1,%rdx
+1:	movdqa (%rax),%xmm0
+	pcmpeqd %xmm1,%xmm0
+	pmovmskb %xmm0,%r8d
+	shr %cl,%r8d
+	test %r8d,%r8d
+	jz 2f
+	bsf %r8d,%r8d
+	cmp %r9,%r8
+	jae 9f
+	lea (%rdi,%r8),%rax
+	ret
+
+	# rdx is the number of bytes in range from the block at rax
+2:	cmp $16,%rdx
+	jbe 9f
+	add $16,%rax
+	sub $16,%rdx
+	movdqa (%rax),%xmm0
+	pcmpeqd %xmm1,%xmm0
+	pmovmskb %xmm0,%r8d
+	test %r8d,%r8d
+	jz 2b
+	bsf %r8d,%r8d
+	cmp %rdx,%r8
+	jae 9f
+	add %r8,%rax
+	ret
+
+9:	xor %eax,%eax
+	ret
@@ -0,0 +1,41 @@
+.global wmemcmp
+.type wmemcmp,@function
+wmemcmp:
+	xor %ecx,%ecx
+	cmp $4,%rdx
+	jb 2f
+
+1:	movdqu (%rdi,%rcx),%xmm0
+	movdqu (%rsi,%rcx),%xmm1
+	pcmpeqd %xmm1,%xmm0
+	pmovmskb %xmm0,%eax
+	xor $0xffff,%eax
+	jnz 3f
+	add $16,%rcx
+	sub $4,%rdx
+	cmp $4,%rdx
+	jae 1b
+
+2:	test %rdx,%rdx
+	jz 5f
+	mov (%rdi,%rcx),%eax
+	mov (%rsi,%rcx),%r8d
+	cmp %r8d,%eax
+	jne 4f
+	add $4,%rcx
+	dec %rdx
+	jmp 2b
+
+3:	bsf %eax,%eax
+	add %rax,%rcx
+	mov (%rdi,%rcx),%eax
+	mov (%rsi,%rcx),%r8d
+4:	cmp %r8d,%eax
+	setg %al
+	setl %dl
+	movzbl %al,%eax
+	movzbl %dl,%edx
+	sub %edx,%eax
+	ret
+5:	xor %eax,%eax
+	ret
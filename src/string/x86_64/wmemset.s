@@ -0,0 +1,48 @@
+.global wmemset
+.type wmemset,@function
+wmemset:
+	mov %rdi,%rax
+	cmp $4,%rdx
+	jb 2f
+	movd %esi,%xmm0
+	pshufd $0,%xmm0,%xmm0
+	shl $2,%rdx
+	cmp $32,%rdx
+	ja 1f
+	movdqu %xmm0,(%rdi)
+	movdqu %xmm0,-16(%rdi,%rdx)
+	ret
+
+1:	cmp $64,%rdx
+	ja 1f
+	movdqu %xmm0,(%rdi)
+	movdqu %xmm0,16(%rdi)
+	movdqu %xmm0,-32(%rdi,%rdx)
+	movdqu %xmm0,-16(%rdi,%rdx)
+	ret
+
+	# unaligned stores throughout, since aligning the destination
+	# would need it to be a multiple of 4 to keep the pattern
+1:	lea -64(%rdi,%rdx),%r9
+1:	movdqu %xmm0,(%rdi)
+	movdqu %xmm0,16(%rdi)
+	movdqu %xmm0,32(%rdi)
+	movdqu %xmm0,48(%rdi)
+	add $64,%rdi
+	cmp %r9,%rdi
+	jb 1b
+	movdqu %xmm0,(%r9)
+	movdqu %xmm0,16(%r9)
+	movdqu %xmm0,32(%r9)
+	movdqu %xmm0,48(%r9)
+	ret
+
+2:	test %edx,%edx
+	jz 3f
+	mov %esi,(%rdi)
+	cmp $2,%edx
+	jb 3f
+	mov %esi,4(%rdi)
+	jz 3f
+	mov %esi,8(%rdi)
+3:	ret
@@ -1,4 +1,5 @@
 #include "pthread_impl.h"
+#include "lockstat.h"
 
 /* This lock primitive combines a flag (in the sign bit) and a
  * congestion count (= threads inside the critical section, CS) in a
@@ -16,14 +17,8 @@
  * with INT_MIN as a lock flag.
  */
 
-void __lock(volatile int *l)
+static void lock_contended(volatile int *l, int current)
 {
-	int need_locks = libc.need_locks;
-	if (!need_locks) return;
-	/* fast path: INT_MIN for the lock, +1 for the congestion */
-	int current = a_cas(l, 0, INT_MIN + 1);
-	if (need_locks < 0) libc.need_locks = 0;
-	if (!current) return;
 	/* A first spin loop, for medium congestion. */
 	for (unsigned i = 0; i < 10; ++i) {
 		if (current < 0) current -= INT_MIN + 1;
@@ -51,6 +46,26 @@ void __lock(volatile int *l)
 	}
 }
 
+void __lock(volatile int *l)
+{
+	int need_locks = libc.need_locks;
+	if (!need_locks) return;
+	/* fast path: INT_MIN for the lock, +1 for the congestion */
+	int current = a_cas(l, 0, INT_MIN + 1);
+	if (need_locks < 0) libc.need_locks = 0;
+	if (!current) {
+		LOCKSTAT_ACQUIRED(l, LOCKSTAT_INTERNAL);
+		return;
+	}
+	if (!__lockstat_on) {
+		lock_contended(l, current);
+		return;
+	}
+	long long t0 = __lockstat_now();
+	lock_contended(l, current);
+	__lockstat_record(l, LOCKSTAT_INTERNAL, t0, 0);
+}
+
 void __unlock(volatile int *l)
 {
 	/* Check l[0] to see if we are multi-threaded. */
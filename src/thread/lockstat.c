@@ -0,0 +1,138 @@
+#include <sys/mman.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include "lockstat.h"
+#include "atomic.h"
+
+/* Statistics live in an open-addressed table keyed by lock address,
+ * mapped on first enable. Slots are claimed with a cas on the key
+ * and never released except by reset, so recording takes no locks
+ * and can be called from inside __lock itself. Counters are updated
+ * with pointer-sized cas loops. */
+
+#define NSLOTS 4096
+#define PROBES 32
+
+struct slot {
+	const volatile void *volatile lock;
+	volatile int kind;
+	volatile unsigned long acq, cont, wait, max, timedout, busy;
+};
+
+volatile int __lockstat_on;
+static struct slot *volatile table;
+static volatile unsigned long dropped;
+
+static void add(volatile unsigned long *p, unsigned long v)
+{
+	unsigned long old;
+	do old = *p;
+	while (a_cas_p(p, (void *)old, (void *)(old+v)) != (void *)old);
+}
+
+static void raise_max(volatile unsigned long *p, unsigned long v)
+{
+	unsigned long old;
+	while ((old = *p) < v && a_cas_p(p, (void *)old, (void *)v) != (void *)old);
+}
+
+static struct slot *lookup(struct slot *t, const volatile void *l)
+{
+	size_t h = (size_t)l >> 3;
+	h ^= h >> 11;
+	h *= 0x9e3779b1;
+	for (int i=0; i<PROBES; i++) {
+		struct slot *s = &t[(h+i) % NSLOTS];
+		const volatile void *k = s->lock;
+		if (!k) k = a_cas_p(&s->lock, 0, (void *)l);
+		if (!k || k == l) return s;
+	}
+	return 0;
+}
+
+long long __lockstat_now(void)
+{
+	struct timespec ts;
+	__clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+void __lockstat_record(const volatile void *l, int kind, long long start, int r)
+{
+	struct slot *t = table, *s;
+	if (!t) return;
+	if (!(s = lookup(t, l))) {
+		add(&dropped, 1);
+		return;
+	}
+	s->kind = kind;
+	if (r && r != EOWNERDEAD) {
+		add(start < 0 ? &s->busy : &s->timedout, 1);
+		return;
+	}
+	add(&s->acq, 1);
+	if (start < 0) return;
+	long long d = __lockstat_now() - start;
+	if (d < 0) d = 0;
+	add(&s->cont, 1);
+	add(&s->wait, d);
+	raise_max(&s->max, d);
+}
+
+int bibon_lockstat_enable(int on)
+{
+	if (on && !table) {
+		void *p = mmap(0, NSLOTS * sizeof(struct slot),
+			PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+		if (p == MAP_FAILED) return -1;
+		if (a_cas_p(&table, 0, p))
+			munmap(p, NSLOTS * sizeof(struct slot));
+	}
+	a_store(&__lockstat_on, !!on);
+	return 0;
+}
+
+void bibon_lockstat_reset(void)
+{
+	/* Accounting that races with a reset may be lost or land in a
+	 * freshly cleared slot; disable first for exact results. */
+	if (table) memset((void *)table, 0, NSLOTS * sizeof(struct slot));
+	dropped = 0;
+}
+
+static int before(const struct bibon_lockstat *a, const struct bibon_lockstat *b)
+{
+	if (a->wait_ns != b->wait_ns) return a->wait_ns > b->wait_ns;
+	if (a->contended != b->contended) return a->contended > b->contended;
+	return a->acquired > b->acquired;
+}
+
+size_t bibon_lockstat_top(struct bibon_lockstat *buf, size_t n)
+{
+	struct slot *t = table;
+	size_t cnt = 0;
+	if (!t || !n) return 0;
+	for (size_t i=0; i<NSLOTS; i++) {
+		struct bibon_lockstat e;
+		if (!t[i].lock || !(t[i].acq|t[i].timedout|t[i].busy)) continue;
+		e.lock = (const void *)t[i].lock;
+		e.kind = t[i].kind;
+		e.acquired = t[i].acq;
+		e.contended = t[i].cont;
+		e.wait_ns = t[i].wait;
+		e.max_wait_ns = t[i].max;
+		e.timedout = t[i].timedout;
+		e.busy = t[i].busy;
+		if (cnt == n && !before(&e, &buf[n-1])) continue;
+		size_t j = cnt < n ? cnt++ : n-1;
+		for (; j && before(&e, &buf[j-1]); j--) buf[j] = buf[j-1];
+		buf[j] = e;
+	}
+	return cnt;
+}
+
+unsigned long __lockstat_dropped(void)
+{
+	return dropped;
+}
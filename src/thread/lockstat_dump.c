@@ -0,0 +1,27 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "lockstat.h"
+
+int bibon_lockstat_dump(int fd, size_t n)
+{
+	static const char kinds[][9] = { "mutex", "rdlock", "wrlock", "internal", "file" };
+	struct bibon_lockstat *buf;
+	size_t i, cnt;
+
+	if (!n) n = 16;
+	if (!(buf = malloc(n * sizeof *buf))) return -1;
+	cnt = bibon_lockstat_top(buf, n);
+	dprintf(fd, "%-18s %-8s %12s %12s %14s %12s %10s %10s\n",
+		"lock", "kind", "acquired", "contended", "wait_ns", "max_ns",
+		"timedout", "busy");
+	for (i=0; i<cnt; i++)
+		dprintf(fd, "%-18p %-8s %12llu %12llu %14llu %12llu %10llu %10llu\n",
+			buf[i].lock, kinds[buf[i].kind%5], buf[i].acquired,
+			buf[i].contended, buf[i].wait_ns, buf[i].max_wait_ns,
+			buf[i].timedout, buf[i].busy);
+	if (__lockstat_dropped())
+		dprintf(fd, "(%lu acquisitions not recorded: table full)\n",
+			__lockstat_dropped());
+	free(buf);
+	return 0;
+}
@@ -0,0 +1,19 @@
+#define _GNU_SOURCE
+#include <sched.h>
+#include "rseq.h"
+
+/* Number of per-cpu slots that objects should be sized for: one
+ * past the highest cpu the process may run on at the time of the
+ * first call. This only needs to be a good estimate. */
+int __percpu_slots(void)
+{
+	static volatile int slots;
+	int i, n = slots;
+	if (!n) {
+		cpu_set_t set;
+		n = __syscall(SYS_sched_getaffinity, 0, sizeof set, &set);
+		for (i=8*n-1; i>=0 && !CPU_ISSET_S(i, n, &set); i--);
+		slots = n = i+1 > 0 ? i+1 : 1;
+	}
+	return n;
+}
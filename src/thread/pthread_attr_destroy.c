@@ -2,5 +2,7 @@
 
 int pthread_attr_destroy(pthread_attr_t *a)
 {
+	free((void *)a->_a_ext);
+	a->_a_ext = 0;
 	return 0;
 }
@@ -0,0 +1,17 @@
+#include <string.h>
+#include "pthread_impl.h"
+
+struct pthread_attr_ext *__pthread_attr_ext(pthread_attr_t *a, size_t setsize)
+{
+	struct pthread_attr_ext *x = (void *)a->_a_ext, *y;
+	if (x && x->cpusetsize >= setsize) return x;
+	if (!(y = malloc(sizeof *y + setsize))) return 0;
+	memset(y, 0, sizeof *y + setsize);
+	if (x) {
+		memcpy(y, x, sizeof *x + x->cpusetsize);
+		free(x);
+	}
+	y->cpusetsize = setsize;
+	a->_a_ext = (unsigned long)y;
+	return y;
+}
@@ -1,3 +1,5 @@
+#define _GNU_SOURCE
+#include <string.h>
 #include "pthread_impl.h"
 
 int pthread_attr_getdetachstate(const pthread_attr_t *a, int *state)
@@ -44,6 +46,50 @@ int pthread_attr_getstack(const pthread_attr_t *restrict a, void **restrict addr
 	return 0;
 }
 
+int pthread_attr_getaffinity_np(const pthread_attr_t *a, size_t size, cpu_set_t *set)
+{
+	const struct pthread_attr_ext *x = (void *)a->_a_ext;
+	size_t i, n = x ? x->cpusetsize : 0;
+	for (i=size; i<n; i++)
+		if (x->cpuset[i]) return EINVAL;
+	for (i=0; i<n && !x->cpuset[i]; i++);
+	if (i == n) {
+		/* No affinity set: the thread may run anywhere */
+		memset(set, -1, size);
+		return 0;
+	}
+	memcpy(set, x->cpuset, n < size ? n : size);
+	if (n < size) memset((char *)set + n, 0, size - n);
+	return 0;
+}
+
+int pthread_attr_getdeadline_np(const pthread_attr_t *restrict a, unsigned long long *restrict runtime, unsigned long long *restrict deadline, unsigned long long *restrict period)
+{
+	const struct pthread_attr_ext *x = (void *)a->_a_ext;
+	if (!x || !(x->flags & ATTR_DEADLINE)) {
+		*runtime = *deadline = *period = 0;
+		return 0;
+	}
+	*runtime = x->dl_runtime;
+	*deadline = x->dl_deadline;
+	*period = x->dl_period;
+	return 0;
+}
+
+int pthread_attr_getprefault_np(const pthread_attr_t *restrict a, int *restrict on)
+{
+	const struct pthread_attr_ext *x = (void *)a->_a_ext;
+	*on = x && (x->flags & ATTR_PREFAULT);
+	return 0;
+}
+
+int pthread_attr_getmlock_np(const pthread_attr_t *restrict a, int *restrict on)
+{
+	const struct pthread_attr_ext *x = (void *)a->_a_ext;
+	*on = x && (x->flags & ATTR_MLOCK);
+	return 0;
+}
+
 int pthread_attr_getstacksize(const pthread_attr_t *restrict a, size_t *restrict size)
 {
 	*size = a->_a_stacksize;
@@ -52,7 +98,13 @@ int pthread_attr_getstacksize(const pthread_attr_t *restrict a, size_t *restrict
 
 int pthread_barrierattr_getpshared(const pthread_barrierattr_t *restrict a, int *restrict pshared)
 {
-	*pshared = !!a->__attr;
+	*pshared = a->__attr < 0;
+	return 0;
+}
+
+int pthread_barrierattr_getkind_np(const pthread_barrierattr_t *restrict a, int *restrict kind)
+{
+	*kind = a->__attr & 3;
 	return 0;
 }
 
@@ -96,3 +148,9 @@ int pthread_rwlockattr_getpshared(const pthread_rwlockattr_t *restrict a, int *r
 	*pshared = a->__attr[0];
 	return 0;
 }
+
+int pthread_rwlockattr_getkind_np(const pthread_rwlockattr_t *restrict a, int *restrict kind)
+{
+	*kind = a->__attr[1];
+	return 0;
+}
@@ -0,0 +1,16 @@
+#define _GNU_SOURCE
+#include <string.h>
+#include "pthread_impl.h"
+
+int pthread_attr_setaffinity_np(pthread_attr_t *a, size_t size, const cpu_set_t *set)
+{
+	struct pthread_attr_ext *x = (void *)a->_a_ext;
+	if (!size || !set) {
+		if (x) memset(x->cpuset, 0, x->cpusetsize);
+		return 0;
+	}
+	if (!(x = __pthread_attr_ext(a, size))) return ENOMEM;
+	memcpy(x->cpuset, set, size);
+	memset(x->cpuset+size, 0, x->cpusetsize-size);
+	return 0;
+}
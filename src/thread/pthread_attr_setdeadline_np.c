@@ -0,0 +1,20 @@
+#define _GNU_SOURCE
+#include "pthread_impl.h"
+
+int pthread_attr_setdeadline_np(pthread_attr_t *a, unsigned long long runtime, unsigned long long deadline, unsigned long long period)
+{
+	struct pthread_attr_ext *x;
+	if (!runtime) {
+		if ((x = (void *)a->_a_ext)) x->flags &= ~ATTR_DEADLINE;
+		return 0;
+	}
+	if (!deadline) deadline = period;
+	if (!period) period = deadline;
+	if (runtime > deadline || deadline > period) return EINVAL;
+	if (!(x = __pthread_attr_ext(a, 0))) return ENOMEM;
+	x->dl_runtime = runtime;
+	x->dl_deadline = deadline;
+	x->dl_period = period;
+	x->flags |= ATTR_DEADLINE;
+	return 0;
+}
@@ -0,0 +1,11 @@
+#define _GNU_SOURCE
+#include "pthread_impl.h"
+
+int pthread_attr_setprefault_np(pthread_attr_t *a, int on)
+{
+	struct pthread_attr_ext *x;
+	if (on > 1U) return EINVAL;
+	if (!(x = __pthread_attr_ext(a, 0))) return ENOMEM;
+	x->flags = on ? x->flags | ATTR_PREFAULT : x->flags & ~ATTR_PREFAULT;
+	return 0;
+}
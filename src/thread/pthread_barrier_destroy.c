@@ -10,6 +10,8 @@ int pthread_barrier_destroy(pthread_barrier_t *b)
 				__wait(&b->_b_lock, 0, v, 0);
 		}
 		__vm_wait();
+	} else if (b->_b_tree) {
+		__pthread_barrier_tree_destroy(b);
 	}
 	return 0;
 }
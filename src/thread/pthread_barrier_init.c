@@ -1,8 +1,20 @@
+#define _GNU_SOURCE
 #include "pthread_impl.h"
 
+/* Above this many threads, private barriers use a combining tree
+ * instead of funneling every arrival through one lock and counter. */
+#define TREE_MIN 32
+
 int pthread_barrier_init(pthread_barrier_t *restrict b, const pthread_barrierattr_t *restrict a, unsigned count)
 {
+	int attr = a ? a->__attr : 0, kind = attr & 3;
 	if (count-1 > INT_MAX-1) return EINVAL;
-	*b = (pthread_barrier_t){ ._b_limit = count-1 | (a?a->__attr:0) };
+	*b = (pthread_barrier_t){ ._b_limit = count-1 | (attr & INT_MIN) };
+	if (attr < 0 || count < 2 || kind == PTHREAD_BARRIER_CENTRAL_NP) return 0;
+	if (kind == PTHREAD_BARRIER_TREE_NP || count >= TREE_MIN) {
+		int r = __pthread_barrier_tree_init(b, count);
+		/* An automatically chosen tree is only an optimization. */
+		if (r && kind == PTHREAD_BARRIER_TREE_NP) return r;
+	}
 	return 0;
 }
@@ -0,0 +1,118 @@
+#include "pthread_impl.h"
+
+/* Combining-tree barrier for private barriers with many threads.
+ *
+ * Arrivals are spread over leaves of at most FANIN threads each; the
+ * last thread to arrive at a node carries on to its parent, and the
+ * last to arrive at the root completes the episode. Each node has its
+ * own release word, and every thread that completed nodes releases
+ * them top down once it is itself released, so wakes fan out through
+ * the tree instead of being issued by a single thread.
+ *
+ * Counters are never reset: episode e owns the window [e*cap, e*cap+cap)
+ * of a node's arrival count, and a node's gen holds the number of
+ * episodes it has released. The tree-wide gen is bumped before any
+ * release, so threads reentering the barrier see their new episode
+ * even while parts of the tree are still releasing the previous one.
+ * A leaf whose window for the current episode is full is skipped,
+ * which hands out exactly count slots per episode. */
+
+#define FANIN 4
+#define LINE 64
+
+struct node {
+	volatile int count, gen, out, waiters;
+	unsigned cap;
+	struct node *parent;
+};
+
+struct tree {
+	volatile int gen;
+	unsigned nleaves, nnodes;
+	void *mem;
+};
+
+#define NODE(t, i) ((struct node *)((char *)(t) + LINE*((i)+1)))
+
+int __pthread_barrier_tree_init(pthread_barrier_t *b, unsigned count)
+{
+	unsigned nl = (count+FANIN-1)/FANIN, nn = 0, m, i, s;
+	struct tree *t;
+	char *mem;
+
+	for (m=nl; nn+=m, m>1; m=(m+FANIN-1)/FANIN);
+	if (!(mem = calloc(nn+2, LINE))) return ENOMEM;
+	t = (void *)(mem + (-(uintptr_t)mem & (LINE-1)));
+	t->mem = mem;
+	t->nleaves = nl;
+	t->nnodes = nn;
+
+	for (i=0; i<nl; i++)
+		NODE(t, i)->cap = count/nl + (i < count%nl);
+	for (s=0, m=nl; m>1; s+=m, m=(m+FANIN-1)/FANIN) {
+		for (i=0; i<m; i++) {
+			struct node *p = NODE(t, s+m+i/FANIN);
+			NODE(t, s+i)->parent = p;
+			p->cap++;
+		}
+	}
+
+	b->_b_tree = t;
+	return 0;
+}
+
+int __pthread_barrier_tree_wait(pthread_barrier_t *b)
+{
+	struct tree *t = b->_b_tree;
+	struct node *n, *won[32];
+	unsigned e = t->gen, c, base, i;
+	int v, depth = 0, ret = 0;
+
+	/* Claim a slot in some leaf, starting from one picked by tid */
+	for (i = __pthread_self()->tid % t->nleaves; ; i = (i+1) % t->nleaves) {
+		n = NODE(t, i);
+		base = e * n->cap;
+		while ((c = n->count) - base < n->cap)
+			if (a_cas(&n->count, c, c+1) == c) goto claimed;
+	}
+claimed:
+	while (c+1 - base == n->cap) {
+		won[depth++] = n;
+		if (!(n = n->parent)) break;
+		base = e * n->cap;
+		c = a_fetch_add(&n->count, 1);
+	}
+
+	if (n) {
+		while ((v = n->gen) != e+1)
+			__wait(&n->gen, &n->waiters, v, 1);
+		a_inc(&n->out);
+	} else {
+		a_store(&t->gen, e+1);
+		ret = PTHREAD_BARRIER_SERIAL_THREAD;
+	}
+
+	while (depth--) {
+		n = won[depth];
+		a_store(&n->gen, e+1);
+		if (n->waiters) __wake(&n->gen, -1, 1);
+		a_inc(&n->out);
+	}
+	return ret;
+}
+
+void __pthread_barrier_tree_destroy(pthread_barrier_t *b)
+{
+	struct tree *t = b->_b_tree;
+	unsigned i;
+
+	/* Threads released by the last episode may still be waking
+	 * their subtrees; each leaves a mark on every node it touched. */
+	for (i=0; i<t->nnodes; i++) {
+		struct node *n = NODE(t, i);
+		while (n->out != (int)(t->gen * n->cap))
+			__syscall(SYS_sched_yield);
+	}
+	free(t->mem);
+	b->_b_tree = 0;
+}
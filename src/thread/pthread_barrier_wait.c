@@ -68,6 +68,8 @@ int pthread_barrier_wait(pthread_barrier_t *b)
 	/* Process-shared barriers require a separate, inefficient wait */
 	if (limit < 0) return pshared_barrier_wait(b);
 
+	if (b->_b_tree) return __pthread_barrier_tree_wait(b);
+
 	/* Otherwise we need a lock on the barrier object */
 	while (a_swap(&b->_b_lock, 1))
 		__wait(&b->_b_lock, &b->_b_waiters, 1, 1);
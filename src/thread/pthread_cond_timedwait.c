@@ -59,6 +59,113 @@ enum {
 	LEAVING,
 };
 
+/*
+ * Priority-inheritance mutexes
+ *
+ * When a private cv is waited on with a process-private PI mutex,
+ * waiters are not put on the waiter list. Instead they sleep on
+ * _c_pi_seq with FUTEX_WAIT_REQUEUE_PI, and signal/broadcast use
+ * FUTEX_CMP_REQUEUE_PI to move them directly onto the mutex's kernel
+ * rt_mutex, or to hand them the mutex if it is free. This way waiters are woken in
+ * priority order, one at a time, as the mutex becomes available.
+ *
+ * The low bit of _c_pi_seq records that waiters may be present so
+ * that signaling an idle cv does not need a syscall; the sequence
+ * itself advances in steps of 2. Only broadcast clears the bit,
+ * since after a signal other waiters may remain.
+ *
+ * The kernel only times these waits against CLOCK_REALTIME and
+ * CLOCK_MONOTONIC; cvs using any other clock keep the waiter list.
+ * A waiter on the list clears _c_pi_mutex, so that a cv reused with
+ * an ordinary mutex is signaled through the list again.
+ */
+
+#define IS32BIT(x) !((x)+0x80000000ULL>>32)
+#define CLAMP(x) (int)(IS32BIT(x) ? (x) : 0x7fffffffU+((0ULL+(x))>>63))
+
+static int futex_wait_requeue_pi_cp(volatile int *addr, int op, int val, const struct timespec *at, volatile int *addr2)
+{
+#ifdef SYS_futex_time64
+	time_t s = at ? at->tv_sec : 0;
+	long ns = at ? at->tv_nsec : 0;
+	int r = -ENOSYS;
+	if (SYS_futex == SYS_futex_time64 || !IS32BIT(s))
+		r = __syscall_cp(SYS_futex_time64, addr, op, val,
+			at ? ((long long[]){s, ns}) : 0, addr2);
+	if (SYS_futex == SYS_futex_time64 || r!=-ENOSYS) return r;
+	at = at ? (void *)(long[]){CLAMP(s), ns} : 0;
+#endif
+	return __syscall_cp(SYS_futex, addr, op, val, at, addr2);
+}
+
+static int pi_cond_timedwait(pthread_cond_t *restrict c, pthread_mutex_t *restrict m, const struct timespec *restrict ts)
+{
+	int e, cs, tmp, seq;
+	int op = FUTEX_WAIT_REQUEUE_PI | FUTEX_PRIVATE;
+
+	if (c->_c_clock == CLOCK_REALTIME) op |= FUTEX_CLOCK_REALTIME;
+
+	/* Both are protected by the mutex, which all waiters hold. */
+	c->_c_pi_mutex = m;
+	seq = a_fetch_or(&c->_c_pi_seq, 1) | 1;
+
+	__pthread_mutex_unlock(m);
+
+	__pthread_setcancelstate(PTHREAD_CANCEL_MASKED, &cs);
+	if (cs == PTHREAD_CANCEL_DISABLE) __pthread_setcancelstate(cs, 0);
+
+	do e = -futex_wait_requeue_pi_cp(&c->_c_pi_seq, op, seq, ts, &m->_m_lock);
+	while (e == EINTR);
+
+	if (!e) {
+		/* The kernel acquired the mutex on our behalf. As after
+		 * FUTEX_LOCK_PI, a non-robust mutex whose owner died must
+		 * not be acquired: release it and lock it the usual way,
+		 * which does not return. Otherwise trylock completes the
+		 * ownership update, and failure there means the mutex
+		 * must be taken the slow way. Since a signal was
+		 * consumed, cancellation is not permitted. */
+		if (!(m->_m_type&4) && ((m->_m_lock & 0x40000000) || m->_m_waiters)) {
+			a_store(&m->_m_waiters, -1);
+			__syscall(SYS_futex, &m->_m_lock, FUTEX_UNLOCK_PI|FUTEX_PRIVATE);
+			e = pthread_mutex_lock(m);
+		} else {
+			m->_m_count = -1;
+			e = __pthread_mutex_trylock(m);
+			if (e == EBUSY) e = pthread_mutex_lock(m);
+		}
+	} else {
+		if (e == EAGAIN) e = 0;
+		if ((tmp = pthread_mutex_lock(m))) e = tmp;
+	}
+
+	__pthread_setcancelstate(cs, 0);
+
+	if (e == ECANCELED) {
+		__pthread_testcancel();
+		__pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, 0);
+	}
+
+	return e;
+}
+
+static void pi_cond_signal(pthread_cond_t *c, int n)
+{
+	pthread_mutex_t *m = c->_c_pi_mutex;
+	int seq, new;
+
+	for (;;) {
+		seq = c->_c_pi_seq;
+		if (!(seq & 1)) return;
+		new = n<0 ? seq+1 : seq+2;
+		if (a_cas(&c->_c_pi_seq, seq, new) != seq) continue;
+		if (__syscall(SYS_futex, &c->_c_pi_seq,
+		    FUTEX_CMP_REQUEUE_PI|FUTEX_PRIVATE, 1,
+		    n<0 ? INT_MAX : 0, &m->_m_lock, new) != -EAGAIN)
+			return;
+	}
+}
+
 int __pthread_cond_timedwait(pthread_cond_t *restrict c, pthread_mutex_t *restrict m, const struct timespec *restrict ts)
 {
 	struct waiter node = { 0 };
@@ -73,6 +180,10 @@ int __pthread_cond_timedwait(pthread_cond_t *restrict c, pthread_mutex_t *restri
 
 	__pthread_testcancel();
 
+	if (!c->_c_shared && (m->_m_type & (8|128)) == 8
+	    && (clock == CLOCK_REALTIME || clock == CLOCK_MONOTONIC))
+		return pi_cond_timedwait(c, m, ts);
+
 	if (c->_c_shared) {
 		shared = 1;
 		fut = &c->_c_seq;
@@ -81,6 +192,7 @@ int __pthread_cond_timedwait(pthread_cond_t *restrict c, pthread_mutex_t *restri
 	} else {
 		lock(&c->_c_lock);
 
+		c->_c_pi_mutex = 0;
 		seq = node.barrier = 2;
 		fut = &node.barrier;
 		node.state = WAITING;
@@ -179,6 +291,11 @@ int __private_cond_signal(pthread_cond_t *c, int n)
 	volatile int ref = 0;
 	int cur;
 
+	if (c->_c_pi_mutex) {
+		pi_cond_signal(c, n);
+		return 0;
+	}
+
 	lock(&c->_c_lock);
 	for (p=c->_c_tail; n && p; p=p->prev) {
 		if (a_cas(&p->state, WAITING, SIGNALED) != WAITING) {
@@ -3,6 +3,7 @@
 #include "stdio_impl.h"
 #include "libc.h"
 #include "lock.h"
+#include "rseq.h"
 #include <sys/mman.h>
 #include <string.h>
 #include <stddef.h>
@@ -16,6 +17,7 @@ weak_alias(dummy_0, __pthread_tsd_run_dtors);
 weak_alias(dummy_0, __do_orphaned_stdio_locks);
 weak_alias(dummy_0, __dl_thread_cleanup);
 weak_alias(dummy_0, __membarrier_init);
+weak_alias(dummy_0, __syscall_audit_exit);
 
 static int tl_lock_count;
 static int tl_lock_waiters;
@@ -68,6 +70,7 @@ _Noreturn void __pthread_exit(void *result)
 	}
 
 	__pthread_tsd_run_dtors();
+	__syscall_audit_exit(self);
 
 	__block_app_sigs(&set);
 
@@ -160,6 +163,10 @@ _Noreturn void __pthread_exit(void *result)
 		if (self->robust_list.off)
 			__syscall(SYS_set_robust_list, 0, 3*sizeof(long));
 
+		/* Likewise the rseq area, which the kernel would otherwise
+		 * write to after it is unmapped. */
+		__rseq_unregister(self);
+
 		/* The following call unmaps the thread's stack mapping
 		 * and then exits without touching the stack. */
 		__unmapself(self->map_base, self->map_size);
@@ -184,13 +191,99 @@ void __do_cleanup_pop(struct __ptcb *cb)
 	__pthread_self()->cancelbuf = cb->__next;
 }
 
+/* pthread_key_create.c overrides this */
+static volatile size_t dummy = 0;
+weak_alias(dummy, __pthread_tsd_size);
+static void *dummy_tsd[1] = { 0 };
+weak_alias(dummy_tsd, __pthread_tsd_main);
+
 struct start_args {
 	void *(*start_func)(void *);
 	void *start_arg;
 	volatile int control;
+	const pthread_attr_t *rt_attr;
+	volatile int *rt_state;
+	int *rt_err;
 	unsigned long sig_mask[_NSIG/8/sizeof(long)];
 };
 
+static void prefault(pthread_t self)
+{
+	/* Stop a page short of the current frame, which is in use. */
+	char *lo = (char *)self->stack - self->stack_size;
+	char *hi = (char *)((uintptr_t)&lo & -PAGE_SIZE) - PAGE_SIZE;
+	lo = (char *)(((uintptr_t)lo + PAGE_SIZE-1) & -PAGE_SIZE);
+	if (hi <= lo) return;
+	if (!__syscall(SYS_madvise, lo, hi-lo, MADV_POPULATE_WRITE)) return;
+	for (; lo < hi; lo += PAGE_SIZE) *(volatile char *)lo = 0;
+}
+
+/* Runs in the new thread before anything else touches its stack,
+ * so that faulting and locking happen on the cpus it is pinned to.
+ * Scheduling comes last to keep setup out of a deadline budget. */
+static int rt_setup(const pthread_attr_t *a)
+{
+	const struct pthread_attr_ext *x = (void *)a->_a_ext;
+	pthread_t self = __pthread_self();
+	size_t i;
+	int r = 0;
+
+	for (i=0; i<x->cpusetsize && !x->cpuset[i]; i++);
+	if (i < x->cpusetsize)
+		r = __syscall(SYS_sched_setaffinity, 0, x->cpusetsize, x->cpuset);
+	if (r) return r;
+
+	if (x->flags & ATTR_MLOCK) {
+		r = __syscall(SYS_mlock, (char *)self->stack - self->stack_size,
+			self->stack_size);
+		if (!r) r = __syscall(SYS_mlock, (char *)self->tsd - libc.tls_size,
+			libc.tls_size + __pthread_tsd_size);
+		if (r) return r;
+	} else if (x->flags & ATTR_PREFAULT) {
+		prefault(self);
+	}
+
+	if (x->flags & ATTR_DEADLINE) {
+#ifdef SYS_sched_setattr
+		struct {
+			uint32_t size, policy;
+			uint64_t flags;
+			int32_t nice;
+			uint32_t priority;
+			uint64_t runtime, deadline, period;
+		} sa = {
+			sizeof sa, SCHED_DEADLINE, 0, 0, 0,
+			x->dl_runtime, x->dl_deadline, x->dl_period
+		};
+		r = __syscall(SYS_sched_setattr, 0, &sa, 0);
+#else
+		r = -ENOSYS;
+#endif
+	} else if (a->_a_sched) {
+		r = __syscall(SYS_sched_setscheduler, 0, a->_a_policy, &a->_a_prio);
+	}
+	return r;
+}
+
+/* The thread is already on the list, but its pthread_t has not been
+ * handed out, so it only needs to take itself off again. The creator
+ * is woken by the kernel through the exit futex once it is gone. */
+static _Noreturn void rt_fail(struct start_args *args, int r)
+{
+	pthread_t self = __pthread_self();
+	volatile int *state = args->rt_state;
+
+	*args->rt_err = r;
+	__tl_lock();
+	if (!--libc.threads_minus_1) libc.need_locks = -1;
+	self->next->prev = self->prev;
+	self->prev->next = self->next;
+	self->prev = self->next = self;
+	__tl_unlock();
+	__syscall(SYS_set_tid_address, state);
+	for (;;) __syscall(SYS_exit, 0);
+}
+
 static int start(void *p)
 {
 	struct start_args *args = p;
@@ -203,6 +296,13 @@ static int start(void *p)
 			for (;;) __syscall(SYS_exit, 0);
 		}
 	}
+	if (args->rt_attr) {
+		int r = rt_setup(args->rt_attr);
+		if (r) rt_fail(args, r);
+		a_store(args->rt_state, 0);
+		__wake(args->rt_state, 1, 0);
+	}
+	__rseq_register(__pthread_self());
 	__syscall(SYS_rt_sigprocmask, SIG_SETMASK, &args->sig_mask, 0, _NSIG/8);
 	__pthread_exit(args->start_func(args->start_arg));
 	return 0;
@@ -212,17 +312,13 @@ static int start_c11(void *p)
 {
 	struct start_args *args = p;
 	int (*start)(void*) = (int(*)(void*)) args->start_func;
+	__rseq_register(__pthread_self());
 	__pthread_exit((void *)(uintptr_t)start(args->start_arg));
 	return 0;
 }
 
 #define ROUND(x) (((x)+PAGE_SIZE-1)&-PAGE_SIZE)
 
-/* pthread_key_create.c overrides this */
-static volatile size_t dummy = 0;
-weak_alias(dummy, __pthread_tsd_size);
-static void *dummy_tsd[1] = { 0 };
-weak_alias(dummy_tsd, __pthread_tsd_main);
 
 static FILE *volatile dummy_file = 0;
 weak_alias(dummy_file, __stdin_used);
@@ -244,6 +340,9 @@ int __pthread_create(pthread_t *restrict res, const pthread_attr_t *restrict att
 		| CLONE_THREAD | CLONE_SYSVSEM | CLONE_SETTLS
 		| CLONE_PARENT_SETTID | CLONE_CHILD_CLEARTID | CLONE_DETACHED;
 	pthread_attr_t attr = { 0 };
+	struct pthread_attr_ext *rt;
+	volatile int rt_state;
+	int rt_err = 0;
 	sigset_t set;
 
 	if (!libc.can_do_threads) return ENOSYS;
@@ -261,6 +360,27 @@ int __pthread_create(pthread_t *restrict res, const pthread_attr_t *restrict att
 		libc.threaded = 1;
 	}
 	if (attrp && !c11) attr = *attrp;
+	rt = (void *)attr._a_ext;
+	if (rt && !rt->flags) {
+		size_t i;
+		for (i=0; i<rt->cpusetsize && !rt->cpuset[i]; i++);
+		if (i == rt->cpusetsize) rt = 0;
+	}
+	/* The kernel refuses SCHED_DEADLINE for a task whose affinity
+	 * does not span its whole root domain, and would only say so
+	 * after the stack has been locked and faulted. A mask leaving
+	 * out cpus the caller may run on is sure to be refused; anything
+	 * else is left for the kernel to decide. */
+	if (rt && (rt->flags & ATTR_DEADLINE)) {
+		unsigned char cur[128];
+		int i, n = 0;
+		for (i=0; i<rt->cpusetsize && !rt->cpuset[i]; i++);
+		if (i < rt->cpusetsize)
+			n = __syscall(SYS_sched_getaffinity, 0, sizeof cur, cur);
+		for (i=0; i<n; i++)
+			if (cur[i] & ~(i < rt->cpusetsize ? rt->cpuset[i] : 0))
+				return EPERM;
+	}
 
 	__acquire_ptc();
 	if (!attrp || c11) {
@@ -336,7 +456,11 @@ int __pthread_create(pthread_t *restrict res, const pthread_attr_t *restrict att
 	struct start_args *args = (void *)stack;
 	args->start_func = entry;
 	args->start_arg = arg;
-	args->control = attr._a_sched ? 1 : 0;
+	args->control = attr._a_sched && !rt ? 1 : 0;
+	args->rt_attr = rt ? &attr : 0;
+	args->rt_state = &rt_state;
+	args->rt_err = &rt_err;
+	rt_state = !!rt;
 
 	/* Application signals (but not the synccall signal) must be
 	 * blocked before the thread list lock can be taken, to ensure
@@ -360,7 +484,7 @@ int __pthread_create(pthread_t *restrict res, const pthread_attr_t *restrict att
 	 * clean up all transient resource usage before returning. */
 	if (ret < 0) {
 		ret = -EAGAIN;
-	} else if (attr._a_sched) {
+	} else if (attr._a_sched && !rt) {
 		ret = __syscall(SYS_sched_setscheduler,
 			new->tid, attr._a_policy, &attr._a_prio);
 		if (a_swap(&args->control, ret ? 3 : 0)==2)
@@ -381,6 +505,18 @@ int __pthread_create(pthread_t *restrict res, const pthread_attr_t *restrict att
 	__restore_sigs(&set);
 	__release_ptc();
 
+	/* The new thread applies the attributes itself, which can mean
+	 * faulting in megabytes of stack, so it is waited for only once
+	 * the thread list is unlocked. Until it reports back nothing can
+	 * reach it through its pthread_t, and if the attributes cannot
+	 * be applied it removes itself from the list and exits. */
+	if (ret >= 0 && rt) {
+		int v;
+		while ((v = rt_state))
+			__wait(&rt_state, 0, v, 0);
+		if (rt_err) ret = rt_err == -ENOMEM ? -EAGAIN : rt_err;
+	}
+
 	if (ret < 0) {
 		if (map) __munmap(map, size);
 		return -ret;
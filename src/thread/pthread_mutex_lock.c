@@ -1,10 +1,13 @@
 #include "pthread_impl.h"
+#include "lockstat.h"
 
 int __pthread_mutex_lock(pthread_mutex_t *m)
 {
 	if ((m->_m_type&15) == PTHREAD_MUTEX_NORMAL
-	    && !a_cas(&m->_m_lock, 0, EBUSY))
+	    && !a_cas(&m->_m_lock, 0, EBUSY)) {
+		LOCKSTAT_ACQUIRED(m, LOCKSTAT_MUTEX);
 		return 0;
+	}
 
 	return __pthread_mutex_timedlock(m, 0);
 }
@@ -1,4 +1,5 @@
 #include "pthread_impl.h"
+#include "lockstat.h"
 
 #define IS32BIT(x) !((x)+0x80000000ULL>>32)
 #define CLAMP(x) (int)(IS32BIT(x) ? (x) : 0x7fffffffU+((0ULL+(x))>>63))
@@ -53,18 +54,11 @@ static int pthread_mutex_timedlock_pi(pthread_mutex_t *restrict m, const struct
 	return e;
 }
 
-int __pthread_mutex_timedlock(pthread_mutex_t *restrict m, const struct timespec *restrict at)
+static int pthread_mutex_timedlock_contended(pthread_mutex_t *restrict m, const struct timespec *restrict at)
 {
-	if ((m->_m_type&15) == PTHREAD_MUTEX_NORMAL
-	    && !a_cas(&m->_m_lock, 0, EBUSY))
-		return 0;
-
 	int type = m->_m_type;
 	int r, t, priv = (type & 128) ^ 128;
 
-	r = __pthread_mutex_trylock(m);
-	if (r != EBUSY) return r;
-
 	if (type&8) return pthread_mutex_timedlock_pi(m, at);
 	
 	int spins = 100;
@@ -89,4 +83,25 @@ int __pthread_mutex_timedlock(pthread_mutex_t *restrict m, const struct timespec
 	return r;
 }
 
+int __pthread_mutex_timedlock(pthread_mutex_t *restrict m, const struct timespec *restrict at)
+{
+	if ((m->_m_type&15) == PTHREAD_MUTEX_NORMAL
+	    && !a_cas(&m->_m_lock, 0, EBUSY)) {
+		LOCKSTAT_ACQUIRED(m, LOCKSTAT_MUTEX);
+		return 0;
+	}
+
+	int r = __pthread_mutex_trylock(m);
+	if (r != EBUSY) {
+		if (!r) LOCKSTAT_ACQUIRED(m, LOCKSTAT_MUTEX);
+		return r;
+	}
+
+	if (!__lockstat_on) return pthread_mutex_timedlock_contended(m, at);
+	long long t0 = __lockstat_now();
+	r = pthread_mutex_timedlock_contended(m, at);
+	__lockstat_record(m, LOCKSTAT_MUTEX, t0, r);
+	return r;
+}
+
 weak_alias(__pthread_mutex_timedlock, pthread_mutex_timedlock);
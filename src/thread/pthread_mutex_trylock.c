@@ -1,4 +1,5 @@
 #include "pthread_impl.h"
+#include "lockstat.h"
 
 int __pthread_mutex_trylock_owner(pthread_mutex_t *m)
 {
@@ -71,4 +72,11 @@ int __pthread_mutex_trylock(pthread_mutex_t *m)
 	return __pthread_mutex_trylock_owner(m);
 }
 
-weak_alias(__pthread_mutex_trylock, pthread_mutex_trylock);
+/* The lock paths call __pthread_mutex_trylock directly and do their
+ * own accounting; only application trylocks are recorded here. */
+int pthread_mutex_trylock(pthread_mutex_t *m)
+{
+	int r = __pthread_mutex_trylock(m);
+	if (__lockstat_on) __lockstat_record(m, LOCKSTAT_MUTEX, -1, r);
+	return r;
+}
@@ -2,5 +2,6 @@
 
 int pthread_rwlock_destroy(pthread_rwlock_t *rw)
 {
+	if (rw->_rw_nind) free(rw->_rw_ind);
 	return 0;
 }
@@ -0,0 +1,87 @@
+#include "pthread_impl.h"
+#include "rseq.h"
+
+/* Reader indicators for PTHREAD_RWLOCK_SCALABLE_NP locks
+ *
+ * Each thread maps by tid onto one of _rw_nind cache-line sized
+ * indicators. A reader claims its indicator by storing its tid there
+ * instead of incrementing the shared lock word, so concurrent readers
+ * on different cpus touch disjoint cache lines. Recursive read locks
+ * by the owner are counted in the next int of the same line, which
+ * only the owner touches; they must not go to the lock word, which a
+ * writer may hold while it waits for the indicator. A reader that
+ * finds its indicator taken by another thread uses the lock word as
+ * usual.
+ *
+ * A writer first takes the lock word, which stops new readers from
+ * claiming indicators, then waits for each claimed indicator to be
+ * released. Claiming an indicator and taking the lock word are both
+ * full barriers, so a reader and a writer racing each other can not
+ * both miss the other. The writer sets the sign bit of an indicator
+ * it is waiting on to request a futex wake. */
+
+static volatile int *indicator(pthread_rwlock_t *rw, int i)
+{
+	uintptr_t base = (uintptr_t)rw->_rw_ind + PERCPU_LINE-1 & -PERCPU_LINE;
+	return (volatile int *)(base + (i & rw->_rw_nind-1) * PERCPU_LINE);
+}
+
+static int write_locked(pthread_rwlock_t *rw)
+{
+	return (rw->_rw_lock & 0x7fffffff) == 0x7fffffff;
+}
+
+int __pthread_rwlock_ind_tryrdlock(pthread_rwlock_t *rw)
+{
+	int tid = __pthread_self()->tid;
+	volatile int *ind = indicator(rw, tid);
+
+	if ((*ind & 0x7fffffff) == tid) {
+		if (ind[1] == INT_MAX) return EAGAIN;
+		ind[1]++;
+		return 0;
+	}
+	if (write_locked(rw) || a_cas(ind, 0, tid)) return EBUSY;
+	if (!write_locked(rw)) return 0;
+
+	/* Back out in favor of the writer. */
+	if (a_swap(ind, 0) < 0) __wake(ind, 1, 1);
+	return EBUSY;
+}
+
+int __pthread_rwlock_ind_unlock(pthread_rwlock_t *rw)
+{
+	int tid = __pthread_self()->tid;
+	volatile int *ind = indicator(rw, tid);
+
+	if ((*ind & 0x7fffffff) != tid) return EPERM;
+	if (ind[1]) {
+		ind[1]--;
+		return 0;
+	}
+	if (a_swap(ind, 0) < 0) __wake(ind, 1, 1);
+	return 0;
+}
+
+int __pthread_rwlock_ind_drain(pthread_rwlock_t *restrict rw, const struct timespec *restrict at, int try)
+{
+	volatile int *ind;
+	int i, r, t;
+
+	for (i=0; i<rw->_rw_nind; i++) {
+		ind = indicator(rw, i);
+		if (!*ind) continue;
+		if (try) return EBUSY;
+
+		int spins = 100;
+		while (spins-- && *ind) a_spin();
+
+		while ((t = *ind)) {
+			t |= 0x80000000;
+			a_cas(ind, t & 0x7fffffff, t);
+			r = __timedwait(ind, t, CLOCK_REALTIME, at, 1);
+			if (r && r != EINTR) return r;
+		}
+	}
+	return 0;
+}
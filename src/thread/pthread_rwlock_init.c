@@ -1,8 +1,19 @@
+#define _GNU_SOURCE
 #include "pthread_impl.h"
+#include "rseq.h"
 
 int pthread_rwlock_init(pthread_rwlock_t *restrict rw, const pthread_rwlockattr_t *restrict a)
 {
 	*rw = (pthread_rwlock_t){0};
 	if (a) rw->_rw_shared = a->__attr[0]*128;
+	if (a && a->__attr[1] == PTHREAD_RWLOCK_SCALABLE_NP && !a->__attr[0]) {
+		/* One reader indicator per cache line, enough for every
+		 * cpu to have its own with threads pinned one per cpu. */
+		int n = 1, cpus = __percpu_slots();
+		while (n < cpus) n *= 2;
+		rw->_rw_ind = calloc(n+1, PERCPU_LINE);
+		if (!rw->_rw_ind) return ENOMEM;
+		rw->_rw_nind = n;
+	}
 	return 0;
 }
@@ -1,12 +1,10 @@
 #include "pthread_impl.h"
+#include "lockstat.h"
 
-int __pthread_rwlock_timedrdlock(pthread_rwlock_t *restrict rw, const struct timespec *restrict at)
+static int rwlock_timedrdlock_contended(pthread_rwlock_t *restrict rw, const struct timespec *restrict at)
 {
 	int r, t;
 
-	r = pthread_rwlock_tryrdlock(rw);
-	if (r != EBUSY) return r;
-	
 	int spins = 100;
 	while (spins-- && rw->_rw_lock && !rw->_rw_waiters) a_spin();
 
@@ -22,4 +20,19 @@ int __pthread_rwlock_timedrdlock(pthread_rwlock_t *restrict rw, const struct tim
 	return r;
 }
 
+int __pthread_rwlock_timedrdlock(pthread_rwlock_t *restrict rw, const struct timespec *restrict at)
+{
+	int r = pthread_rwlock_tryrdlock(rw);
+	if (r != EBUSY) {
+		if (!r) LOCKSTAT_ACQUIRED(rw, LOCKSTAT_RDLOCK);
+		return r;
+	}
+
+	if (!__lockstat_on) return rwlock_timedrdlock_contended(rw, at);
+	long long t0 = __lockstat_now();
+	r = rwlock_timedrdlock_contended(rw, at);
+	__lockstat_record(rw, LOCKSTAT_RDLOCK, t0, r);
+	return r;
+}
+
 weak_alias(__pthread_rwlock_timedrdlock, pthread_rwlock_timedrdlock);
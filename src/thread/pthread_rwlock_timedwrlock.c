@@ -1,16 +1,14 @@
 #include "pthread_impl.h"
+#include "lockstat.h"
 
-int __pthread_rwlock_timedwrlock(pthread_rwlock_t *restrict rw, const struct timespec *restrict at)
+static int rwlock_timedwrlock_contended(pthread_rwlock_t *restrict rw, const struct timespec *restrict at)
 {
 	int r, t;
-	
-	r = pthread_rwlock_trywrlock(rw);
-	if (r != EBUSY) return r;
-	
+
 	int spins = 100;
 	while (spins-- && rw->_rw_lock && !rw->_rw_waiters) a_spin();
 
-	while ((r=__pthread_rwlock_trywrlock(rw))==EBUSY) {
+	while ((r=a_cas(&rw->_rw_lock, 0, 0x7fffffff))) {
 		if (!(r=rw->_rw_lock)) continue;
 		t = r | 0x80000000;
 		a_inc(&rw->_rw_waiters);
@@ -19,6 +17,26 @@ int __pthread_rwlock_timedwrlock(pthread_rwlock_t *restrict rw, const struct tim
 		a_dec(&rw->_rw_waiters);
 		if (r && r != EINTR) return r;
 	}
+
+	/* Readers holding indicators still have to leave. New readers
+	 * see the write lock and queue on it instead. */
+	if (rw->_rw_nind && (r = __pthread_rwlock_ind_drain(rw, at, 0)))
+		__pthread_rwlock_unlock_word(rw);
+	return r;
+}
+
+int __pthread_rwlock_timedwrlock(pthread_rwlock_t *restrict rw, const struct timespec *restrict at)
+{
+	int r = pthread_rwlock_trywrlock(rw);
+	if (r != EBUSY) {
+		if (!r) LOCKSTAT_ACQUIRED(rw, LOCKSTAT_WRLOCK);
+		return r;
+	}
+
+	if (!__lockstat_on) return rwlock_timedwrlock_contended(rw, at);
+	long long t0 = __lockstat_now();
+	r = rwlock_timedwrlock_contended(rw, at);
+	__lockstat_record(rw, LOCKSTAT_WRLOCK, t0, r);
 	return r;
 }
 
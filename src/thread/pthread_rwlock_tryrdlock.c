@@ -3,6 +3,8 @@
 int __pthread_rwlock_tryrdlock(pthread_rwlock_t *rw)
 {
 	int val, cnt;
+	if (rw->_rw_nind && (cnt = __pthread_rwlock_ind_tryrdlock(rw)) != EBUSY)
+		return cnt;
 	do {
 		val = rw->_rw_lock;
 		cnt = val & 0x7fffffff;
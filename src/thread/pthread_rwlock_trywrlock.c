@@ -3,6 +3,12 @@
 int __pthread_rwlock_trywrlock(pthread_rwlock_t *rw)
 {
 	if (a_cas(&rw->_rw_lock, 0, 0x7fffffff)) return EBUSY;
+	/* Back out through the lock word only: the caller may hold a
+	 * read indicator of its own, which must stay claimed. */
+	if (rw->_rw_nind && __pthread_rwlock_ind_drain(rw, 0, 1)) {
+		__pthread_rwlock_unlock_word(rw);
+		return EBUSY;
+	}
 	return 0;
 }
 
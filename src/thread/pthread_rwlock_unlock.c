@@ -1,6 +1,6 @@
 #include "pthread_impl.h"
 
-int __pthread_rwlock_unlock(pthread_rwlock_t *rw)
+int __pthread_rwlock_unlock_word(pthread_rwlock_t *rw)
 {
 	int val, cnt, waiters, new, priv = rw->_rw_shared^128;
 
@@ -17,4 +17,10 @@ int __pthread_rwlock_unlock(pthread_rwlock_t *rw)
 	return 0;
 }
 
+int __pthread_rwlock_unlock(pthread_rwlock_t *rw)
+{
+	if (rw->_rw_nind && !__pthread_rwlock_ind_unlock(rw)) return 0;
+	return __pthread_rwlock_unlock_word(rw);
+}
+
 weak_alias(__pthread_rwlock_unlock, pthread_rwlock_unlock);
@@ -0,0 +1,9 @@
+#define _GNU_SOURCE
+#include "pthread_impl.h"
+
+int pthread_rwlockattr_setkind_np(pthread_rwlockattr_t *a, int kind)
+{
+	if (kind > 3U) return EINVAL;
+	a->__attr[1] = kind;
+	return 0;
+}
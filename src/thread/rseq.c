@@ -0,0 +1,42 @@
+#include <stdlib.h>
+#include <string.h>
+#include "rseq.h"
+
+static int disabled;
+
+/* BIBON_RSEQ=0 leaves rseq to the application, for programs that
+ * use a library registering its own area, such as librseq or
+ * tcmalloc: the kernel accepts only one area per thread. The main
+ * thread was registered before the environment was available, so
+ * it is unregistered here. */
+void __rseq_init(void)
+{
+	const char *s = getenv("BIBON_RSEQ");
+	if (!s || strcmp(s, "0")) return;
+	disabled = 1;
+	__rseq_unregister(__pthread_self());
+}
+
+void __rseq_register(pthread_t td)
+{
+	struct rseq_area *rs = (void *)((uintptr_t)td->rseq_space + 31 & -32);
+	rs->cpu_id_start = 0;
+	rs->cpu_id = RSEQ_CPU_ID_UNINITIALIZED;
+	rs->rseq_cs = 0;
+	rs->flags = 0;
+	td->rseq = rs;
+#ifdef RSEQ_SIG
+	if (disabled || __syscall(SYS_rseq, rs, RSEQ_AREA_SIZE, 0, RSEQ_SIG))
+		rs->cpu_id = RSEQ_CPU_ID_REGISTRATION_FAILED;
+#endif
+}
+
+void __rseq_unregister(pthread_t td)
+{
+#ifdef RSEQ_SIG
+	struct rseq_area *rs = td->rseq;
+	if (!rs || (int)rs->cpu_id < 0) return;
+	__syscall(SYS_rseq, rs, RSEQ_AREA_SIZE, RSEQ_FLAG_UNREGISTER, RSEQ_SIG);
+	rs->cpu_id = RSEQ_CPU_ID_UNINITIALIZED;
+#endif
+}
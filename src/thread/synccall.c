@@ -1,5 +1,4 @@
 #include "pthread_impl.h"
-#include <semaphore.h>
 #include <string.h>
 
 static void dummy_0(void)
@@ -9,34 +8,71 @@ static void dummy_0(void)
 weak_alias(dummy_0, __tl_lock);
 weak_alias(dummy_0, __tl_unlock);
 
-static int target_tid;
+/* All other threads are signaled at once and their arrival is
+ * collected through a shared counter, rather than one signal and
+ * acknowledgement at a time. A thread's synccall field moves from
+ * 1 (signaled) to 2 (caught) to 3 (its turn), so stray SIGSYNCCALL
+ * signals are ignored. Callbacks still run one at a time, in thread
+ * list order, but each caught thread hands over directly to the
+ * next one instead of going back through the caller. */
+
 static void (*callback)(void *), *context;
-static sem_t target_sem, caller_sem, exit_sem;
+static pthread_t caller;
+static volatile int target, arrived, finished, leaving, phase;
 
 static void dummy(void *p)
 {
 }
 
+static void arrive(volatile int *cnt)
+{
+	if (a_fetch_add(cnt, 1)+1 == target)
+		__wake(cnt, 1, 1);
+}
+
+static void collect(volatile int *cnt)
+{
+	int c;
+	while ((c = *cnt) != target)
+		__futexwait(cnt, c, 1);
+}
+
+static void pass(pthread_t td)
+{
+	if (td != caller && td->synccall == 2) {
+		a_store(&td->synccall, 3);
+		__wake(&td->synccall, 1, 1);
+	} else {
+		a_store(&finished, 1);
+		__wake(&finished, 1, 1);
+	}
+}
+
 static void handler(int sig)
 {
-	if (__pthread_self()->tid != target_tid) return;
+	pthread_t self = __pthread_self();
+	int c;
+
+	if (a_cas(&self->synccall, 1, 2) != 1) return;
 
 	int old_errno = errno;
 
 	/* Inform caller we have received signal and wait for
-	 * the caller to let us make the callback. */
-	sem_post(&caller_sem);
-	sem_wait(&target_sem);
+	 * our turn to make the callback. */
+	arrive(&arrived);
+	while ((c = self->synccall) != 3)
+		__futexwait(&self->synccall, c, 1);
 
 	callback(context);
+	pass(self->next);
 
-	/* Inform caller we've complered the callback and wait
-	 * for the caller to release us to return. */
-	sem_post(&caller_sem);
-	sem_wait(&exit_sem);
+	/* Wait for the caller to release us to return. */
+	while ((c = phase) != 2)
+		__futexwait(&phase, c, 1);
 
-	/* Inform caller we are returning and state is destroyable. */
-	sem_post(&caller_sem);
+	/* Inform caller we are returning and state is reusable. */
+	self->synccall = 0;
+	arrive(&leaving);
 
 	errno = old_errno;
 }
@@ -44,10 +80,9 @@ static void handler(int sig)
 void __synccall(void (*func)(void *), void *ctx)
 {
 	sigset_t oldmask;
-	int cs, i, r;
+	int cs, r, count = 0;
 	struct sigaction sa = { .sa_flags = SA_RESTART | SA_ONSTACK, .sa_handler = handler };
 	pthread_t self = __pthread_self(), td;
-	int count = 0;
 
 	/* Blocking signals in two steps, first only app-level signals
 	 * before taking the lock, then all signals after taking the lock,
@@ -60,15 +95,14 @@ void __synccall(void (*func)(void *), void *ctx)
 	__block_all_sigs(0);
 	pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, &cs);
 
-	sem_init(&target_sem, 0, 0);
-	sem_init(&caller_sem, 0, 0);
-	sem_init(&exit_sem, 0, 0);
-
 	if (!libc.threads_minus_1 || __syscall(SYS_gettid) != self->tid)
 		goto single_threaded;
 
 	callback = func;
 	context = ctx;
+	caller = self;
+	arrived = finished = leaving = phase = 0;
+	target = libc.threads_minus_1;
 
 	/* Block even implementation-internal signals, so that nothing
 	 * interrupts the SIGSYNCCALL handlers. The main possible source
@@ -76,27 +110,33 @@ void __synccall(void (*func)(void *), void *ctx)
 	memset(&sa.sa_mask, -1, sizeof sa.sa_mask);
 	__libc_sigaction(SIGSYNCCALL, &sa, 0);
 
-
 	for (td=self->next; td!=self; td=td->next) {
-		target_tid = td->tid;
+		td->synccall = 1;
 		while ((r = -__syscall(SYS_tkill, td->tid, SIGSYNCCALL)) == EAGAIN);
 		if (r) {
 			/* If we failed to signal any thread, nop out the
 			 * callback to abort the synccall and just release
 			 * any threads already caught. */
+			td->synccall = 0;
 			callback = func = dummy;
 			break;
 		}
-		sem_wait(&caller_sem);
 		count++;
 	}
-	target_tid = 0;
 
-	/* Serialize execution of callback in caught threads, or just
-	 * release them all if synccall is being aborted. */
-	for (i=0; i<count; i++) {
-		sem_post(&target_sem);
-		sem_wait(&caller_sem);
+	/* On abort fewer threads than expected will arrive. Handlers
+	 * compare against target after counting themselves, so the
+	 * barrier orders this store against their increments. */
+	if (count != target) {
+		target = count;
+		a_barrier();
+	}
+
+	collect(&arrived);
+	if (count) {
+		pass(self->next);
+		while (!finished)
+			__futexwait(&finished, 0, 1);
 	}
 
 	sa.sa_handler = SIG_IGN;
@@ -107,14 +147,11 @@ single_threaded:
 
 	/* Only release the caught threads once all threads, including the
 	 * caller, have returned from the callback function. */
-	for (i=0; i<count; i++)
-		sem_post(&exit_sem);
-	for (i=0; i<count; i++)
-		sem_wait(&caller_sem);
-
-	sem_destroy(&caller_sem);
-	sem_destroy(&target_sem);
-	sem_destroy(&exit_sem);
+	if (count) {
+		a_store(&phase, 2);
+		__wake(&phase, -1, 1);
+		collect(&leaving);
+	}
 
 	pthread_setcancelstate(cs, 0);
 	__tl_unlock();
@@ -7,6 +7,7 @@
 #include <ctype.h>
 #include "libc.h"
 #include "lock.h"
+#include "atomic.h"
 #include "fork_impl.h"
 
 #define malloc __libc_malloc
@@ -38,6 +39,31 @@ static size_t old_tz_size = sizeof old_tz_buf;
 static volatile int lock[1];
 volatile int *const __timezone_lockptr = lock;
 
+/* Result of the last UTC-to-local lookup and the range of times it
+ * holds for, published under a sequence counter so that repeated
+ * conversions in the same interval need neither the lock nor the
+ * rule search. The interval never crosses a transition or the end
+ * of a year, and the entry is keyed by the TZ value it came from.
+ * It is dropped whenever a new zone is loaded. */
+
+static struct {
+	volatile int seq;
+	char tz[32];
+	long long lo, hi;
+	int isdst;
+	long offset, oppoff;
+	const char *zonename;
+} cache;
+
+static void cache_clear(void)
+{
+	a_inc(&cache.seq);
+	a_barrier();
+	cache.lo = cache.hi = 0;
+	a_barrier();
+	a_inc(&cache.seq);
+}
+
 static int getint(const char **p)
 {
 	unsigned x;
@@ -137,6 +163,10 @@ static void do_tzset()
 
 	if (old_tz && !strcmp(s, old_tz)) return;
 
+	/* The cached zone name points into the mapping or the name
+	 * buffers about to be replaced, so drop it first. */
+	cache_clear();
+
 	for (i=0; i<5; i++) r0[i] = r1[i] = 0;
 
 	if (zi) __munmap((void *)zi, map_size);
@@ -259,7 +289,7 @@ static void do_tzset()
 /* Search zoneinfo rules to find the one that applies to the given time,
  * and determine alternate opposite-DST-status rule that may be needed. */
 
-static size_t scan_trans(long long t, int local, size_t *alt)
+static size_t scan_trans(long long t, int local, size_t *alt, long long *lo, long long *hi)
 {
 	int scale = 3 - (trans == zi+44);
 	uint64_t x;
@@ -272,6 +302,9 @@ static size_t scan_trans(long long t, int local, size_t *alt)
 		return 0;
 	}
 
+	/* lo and hi are only asked for with local==0, and are left
+	 * alone where the range is unbounded. */
+
 	/* Binary search for 'most-recent rule before t'. */
 	while (n > 1) {
 		m = a + n/2;
@@ -290,7 +323,19 @@ static size_t scan_trans(long long t, int local, size_t *alt)
 	/* First and last entry are special. First means to use lowest-index
 	 * non-DST type. Last means to apply POSIX-style rule if available. */
 	n = (index-trans)>>scale;
+	if (lo) {
+		x = zi_read32(trans + (a<<scale));
+		if (scale == 3) x = x<<32 | zi_read32(trans + (a<<scale) + 4);
+		else x = (int32_t)x;
+		*lo = x;
+	}
 	if (a == n-1) return -1;
+	if (hi) {
+		x = zi_read32(trans + (a+1<<scale));
+		if (scale == 3) x = x<<32 | zi_read32(trans + (a+1<<scale) + 4);
+		else x = (int32_t)x;
+		*hi = x;
+	}
 	if (a == 0) {
 		x = zi_read32(trans);
 		if (scale == 3) x = x<<32 | zi_read32(trans + 4);
@@ -305,6 +350,8 @@ static size_t scan_trans(long long t, int local, size_t *alt)
 		 * and the index-zero (after transition) type as the alt. */
 		if (t - off < (int64_t)x) {
 			if (alt) *alt = index[0];
+			if (lo) *lo = LLONG_MIN;
+			if (hi) *hi = x;
 			return j/6;
 		}
 	}
@@ -354,6 +401,54 @@ static long long rule_to_secs(const int *rule, int year)
 	return t;
 }
 
+/* Look up a universal time in the interval cached by the last call
+ * that took the lock, without taking it. The sequence count is odd
+ * while cache_put is writing, and a change of TZ since then is a
+ * miss. Returns 1 and fills in the results on a hit. */
+
+static int cache_get(long long t, int *isdst, long *offset, long *oppoff, const char **zonename)
+{
+	const char *s = getenv("TZ");
+	int seq;
+
+	if (!s) s = "/etc/localtime";
+	if (!*s) s = __utc;
+	do {
+		seq = cache.seq;
+		a_barrier();
+		if (t < cache.lo || t >= cache.hi
+		    || strncmp(s, cache.tz, sizeof cache.tz))
+			return 0;
+		*isdst = cache.isdst;
+		*offset = cache.offset;
+		if (oppoff) *oppoff = cache.oppoff;
+		*zonename = cache.zonename;
+		a_barrier();
+	} while ((seq & 1) || seq != cache.seq);
+	return 1;
+}
+
+static void cache_put(long long lo, long long hi, int isdst, long offset, long oppoff, const char *zonename)
+{
+	size_t l = old_tz ? strlen(old_tz) : sizeof cache.tz;
+
+	a_inc(&cache.seq);
+	a_barrier();
+	if (l < sizeof cache.tz) {
+		memcpy(cache.tz, old_tz, l+1);
+		cache.lo = lo;
+		cache.hi = hi;
+	} else {
+		cache.lo = cache.hi = 0;
+	}
+	cache.isdst = isdst;
+	cache.offset = offset;
+	cache.oppoff = oppoff;
+	cache.zonename = zonename;
+	a_barrier();
+	a_inc(&cache.seq);
+}
+
 /* Determine the time zone in effect for a given time in seconds since the
  * epoch. It can be given in local or universal time. The results will
  * indicate whether DST is in effect at the queried time, and will give both
@@ -363,19 +458,25 @@ static long long rule_to_secs(const int *rule, int year)
 
 void __secs_to_zone(long long t, int local, int *isdst, long *offset, long *oppoff, const char **zonename)
 {
+	long long lo = LLONG_MIN, hi = LLONG_MAX;
+	long opp;
+
+	if (!local && cache_get(t, isdst, offset, oppoff, zonename))
+		return;
+
 	LOCK(lock);
 
 	do_tzset();
 
 	if (zi) {
-		size_t alt, i = scan_trans(t, local, &alt);
+		size_t alt, i = scan_trans(t, local, &alt,
+			local ? 0 : &lo, local ? 0 : &hi);
 		if (i != -1) {
 			*isdst = types[6*i+4];
 			*offset = (int32_t)zi_read32(types+6*i);
 			*zonename = (const char *)abbrevs + types[6*i+5];
-			if (oppoff) *oppoff = (int32_t)zi_read32(types+6*alt);
-			UNLOCK(lock);
-			return;
+			opp = (int32_t)zi_read32(types+6*alt);
+			goto done;
 		}
 	}
 
@@ -390,29 +491,53 @@ void __secs_to_zone(long long t, int local, int *isdst, long *offset, long *oppo
 	long long t0 = rule_to_secs(r0, y);
 	long long t1 = rule_to_secs(r1, y);
 
+	/* Either year boundary may resolve to the neighbouring year,
+	 * so the cached range stays strictly inside. */
 	if (!local) {
 		t0 += __timezone;
 		t1 += dst_off;
+		if (lo <= __year_to_secs(y, 0)) lo = __year_to_secs(y, 0) + 1;
+		if (hi > __year_to_secs(y+1, 0)) hi = __year_to_secs(y+1, 0);
 	}
 	if (t0 < t1) {
-		if (t >= t0 && t < t1) goto dst;
+		if (t >= t0 && t < t1) {
+			if (lo < t0) lo = t0;
+			if (hi > t1) hi = t1;
+			goto dst;
+		}
+		if (t < t0) {
+			if (hi > t0) hi = t0;
+		} else {
+			if (lo < t1) lo = t1;
+		}
 		goto std;
 	} else {
-		if (t >= t1 && t < t0) goto std;
+		if (t >= t1 && t < t0) {
+			if (lo < t1) lo = t1;
+			if (hi > t0) hi = t0;
+			goto std;
+		}
+		if (t < t1) {
+			if (hi > t1) hi = t1;
+		} else {
+			if (lo < t0) lo = t0;
+		}
 		goto dst;
 	}
 std:
 	*isdst = 0;
 	*offset = -__timezone;
-	if (oppoff) *oppoff = -dst_off;
+	opp = -dst_off;
 	*zonename = __tzname[0];
-	UNLOCK(lock);
-	return;
+	goto done;
 dst:
 	*isdst = 1;
 	*offset = -dst_off;
-	if (oppoff) *oppoff = -__timezone;
+	opp = -__timezone;
 	*zonename = __tzname[1];
+done:
+	if (oppoff) *oppoff = opp;
+	if (!local) cache_put(lo, hi, *isdst, *offset, opp, *zonename);
 	UNLOCK(lock);
 }
 
@@ -0,0 +1,181 @@
+#include <stdint.h>
+#include <time.h>
+#include <bibon/clock.h>
+#include "tsc_arch.h"
+#include "pthread_impl.h"
+
+/* Counter values convert to nanoseconds as
+ *
+ *   ns = base_ns + ((tsc - base_tsc) * mult >> shift)
+ *
+ * with mult < 2^32 so that the product can be split into two 64-bit
+ * halves. The parameters are published under a sequence counter.
+ * Once per RECAL_NS a reader re-anchors them against CLOCK_MONOTONIC:
+ * the new base is the old prediction, so the clock stays continuous,
+ * and the rate is set to the long-term counter frequency slewed by
+ * at most MAX_SLEW to absorb the remaining offset over the next
+ * interval. */
+
+#define CAL_NS 5000000
+#define RECAL_NS 1000000000
+#define MAX_SLEW 0.0005
+
+enum { UNINIT, BUSY, READY, UNUSABLE };
+
+static volatile int state, seq, updating;
+static volatile uint64_t base_tsc, base_ns, next_tsc;
+static volatile uint32_t mult, shift;
+static uint64_t ref_tsc, ref_ns, freq;
+
+static uint64_t mono_ns(void)
+{
+	struct timespec ts;
+	__clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/* Use the tightest of a few bracketed readings */
+static void sample(uint64_t *tsc, uint64_t *ns)
+{
+	uint64_t best = -1;
+	for (int i=0; i<5; i++) {
+		uint64_t t0 = __tsc_read(), n = mono_ns(), t1 = __tsc_read();
+		if (t1-t0 < best) {
+			best = t1-t0;
+			*tsc = t0 + (t1-t0)/2;
+			*ns = n;
+		}
+	}
+}
+
+static uint64_t scale(uint64_t d, uint32_t m, uint32_t s)
+{
+	return (d >> s) * m + ((d & ((1ULL<<s)-1)) * m >> s);
+}
+
+static uint64_t convert(uint64_t t, uint64_t *next)
+{
+	uint64_t ns;
+	int s;
+	do {
+		s = seq;
+		a_barrier();
+		if ((int64_t)(t - base_tsc) >= 0)
+			ns = base_ns + scale(t - base_tsc, mult, shift);
+		else
+			ns = base_ns - scale(base_tsc - t, mult, shift);
+		if (next) *next = next_tsc;
+		a_barrier();
+	} while ((s & 1) || s != seq);
+	return ns;
+}
+
+static void publish(uint64_t tsc, uint64_t ns, double ns_per_tick)
+{
+	uint32_t s = 32;
+	while (s && ns_per_tick * (1ULL<<s) >= 4294967296.0) s--;
+	a_inc(&seq);
+	a_barrier();
+	base_tsc = tsc;
+	base_ns = ns;
+	mult = ns_per_tick * (1ULL<<s);
+	shift = s;
+	next_tsc = tsc + (uint64_t)(RECAL_NS / ns_per_tick);
+	a_barrier();
+	a_inc(&seq);
+}
+
+static void correct(void)
+{
+	uint64_t tsc, ns, pred;
+	double rate, slew;
+
+	if (a_swap(&updating, 1)) return;
+	sample(&tsc, &ns);
+	pred = convert(tsc, 0);
+	rate = (double)(ns - ref_ns) / (tsc - ref_tsc);
+	slew = ((double)ns - (double)pred) / RECAL_NS;
+	if (slew > MAX_SLEW) slew = MAX_SLEW;
+	if (slew < -MAX_SLEW) slew = -MAX_SLEW;
+	freq = 1e9 / rate;
+	publish(tsc, pred, rate * (1 + slew));
+	a_store(&updating, 0);
+}
+
+static void set_state(int s)
+{
+	a_store(&state, s);
+	__wake(&state, -1, 1);
+}
+
+int bibon_clock_init(void)
+{
+	uint64_t t0, n0, t1, n1;
+	int s = a_cas(&state, UNINIT, BUSY);
+
+	if (s == READY) return 0;
+	if (s == BUSY) {
+		/* Wait out the calibrating thread rather than fall back,
+		 * so that ticks are in one unit for the whole process. */
+		while ((s = state) == BUSY) __wait(&state, 0, BUSY, 1);
+		return s == READY ? 0 : -1;
+	}
+	if (s != UNINIT) return -1;
+	if (!__tsc_usable()) {
+		set_state(UNUSABLE);
+		return -1;
+	}
+	sample(&t0, &n0);
+	do sample(&t1, &n1);
+	while (n1 - n0 < CAL_NS);
+	if (t1 <= t0) {
+		set_state(UNUSABLE);
+		return -1;
+	}
+	ref_tsc = t0;
+	ref_ns = n0;
+	freq = (t1-t0) * 1e9 / (n1-n0);
+	publish(t1, n1, (double)(n1-n0) / (t1-t0));
+	set_state(READY);
+	return 0;
+}
+
+unsigned long long bibon_clock_ticks(void)
+{
+	if (state != READY && bibon_clock_init()) return mono_ns();
+	return __tsc_read();
+}
+
+unsigned long long bibon_clock_freq(void)
+{
+	if (state != READY && bibon_clock_init()) return 1000000000;
+	return freq;
+}
+
+unsigned long long bibon_clock_ticks_to_ns(unsigned long long t)
+{
+	uint64_t next, ns;
+	if (state != READY && bibon_clock_init()) return t;
+	ns = convert(t, &next);
+	if ((int64_t)(t - next) >= 0) correct();
+	return ns;
+}
+
+unsigned long long bibon_clock_ns(void)
+{
+	if (state != READY && bibon_clock_init()) return mono_ns();
+	return bibon_clock_ticks_to_ns(__tsc_read());
+}
+
+void bibon_clock_ticks_to_timespec(unsigned long long t, struct timespec *ts)
+{
+	uint64_t ns = bibon_clock_ticks_to_ns(t);
+	ts->tv_sec = ns / 1000000000;
+	ts->tv_nsec = ns % 1000000000;
+}
+
+int bibon_clock_gettime(struct timespec *ts)
+{
+	bibon_clock_ticks_to_timespec(bibon_clock_ticks(), ts);
+	return 0;
+}
@@ -0,0 +1,87 @@
+#include <time.h>
+#include <errno.h>
+#include <string.h>
+#include <bibon/periodic.h>
+#include <bibon/sleep.h>
+#include "atomic.h"
+
+static long long now(clockid_t clk)
+{
+	struct timespec ts;
+	__clock_gettime(clk, &ts);
+	return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+int bibon_periodic_init(struct bibon_periodic *p, clockid_t clk, const struct timespec *period, const struct timespec *start, int flags)
+{
+	struct timespec ts;
+	long long per;
+
+	if ((unsigned long)period->tv_nsec >= 1000000000 || period->tv_sec < 0
+	    || (start && (unsigned long)start->tv_nsec >= 1000000000)) {
+		errno = EINVAL;
+		return -1;
+	}
+	per = period->tv_sec * 1000000000LL + period->tv_nsec;
+	if (per <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+	if (__clock_gettime(clk, &ts)) return -1;
+
+	memset(p, 0, sizeof *p);
+	p->clock = clk;
+	p->flags = flags;
+	p->period = per;
+	if (start) p->next = start->tv_sec * 1000000000LL + start->tv_nsec;
+	else p->next = ts.tv_sec * 1000000000LL + ts.tv_nsec + per;
+	return 0;
+}
+
+long bibon_periodic_wait(struct bibon_periodic *p)
+{
+	long long t, late, skip = 0;
+	struct timespec ts;
+	int r, b;
+
+	/* A cycle that ran past whole periods drops the releases it
+	 * overran instead of replaying them back to back. */
+	t = now(p->clock);
+	if (t - p->next >= p->period) {
+		skip = (t - p->next) / p->period;
+		p->next += skip * p->period;
+		p->missed += skip;
+	}
+
+	ts.tv_sec = p->next / 1000000000;
+	ts.tv_nsec = p->next % 1000000000;
+	do {
+		if (p->flags & BIBON_PERIODIC_PRECISE)
+			r = bibon_nanosleep_precise(p->clock, TIMER_ABSTIME, &ts, 0);
+		else
+			r = __clock_nanosleep(p->clock, TIMER_ABSTIME, &ts, 0);
+	} while (r == EINTR);
+	if (r) {
+		errno = r;
+		return -1;
+	}
+
+	late = now(p->clock) - p->next;
+	if (late < 0) late = 0;
+	b = late ? 64 - a_clz_64(late) : 0;
+	if (b >= BIBON_PERIODIC_HIST) b = BIBON_PERIODIC_HIST-1;
+	p->hist[b]++;
+	p->cycles++;
+	p->last_late = late;
+	p->sum_late += late;
+	if (late > p->max_late) p->max_late = late;
+	p->next += p->period;
+	return skip;
+}
+
+void bibon_periodic_reset(struct bibon_periodic *p)
+{
+	p->cycles = p->missed = p->sum_late = 0;
+	p->last_late = p->max_late = 0;
+	memset(p->hist, 0, sizeof p->hist);
+}
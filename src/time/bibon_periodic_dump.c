@@ -0,0 +1,20 @@
+#include <stdio.h>
+#include <bibon/periodic.h>
+
+int bibon_periodic_dump(const struct bibon_periodic *p, int fd)
+{
+	int i, r;
+
+	r = dprintf(fd, "period %lldns cycles %llu missed %llu mean %lluns max %lldns\n",
+		p->period, p->cycles, p->missed,
+		p->cycles ? p->sum_late / p->cycles : 0, p->max_late);
+	for (i=0; i<BIBON_PERIODIC_HIST; i++) {
+		if (r < 0) return -1;
+		if (!p->hist[i]) continue;
+		if (!i) r = dprintf(fd, "%12s %12s %12llu\n", "0", "1", p->hist[i]);
+		else if (i == BIBON_PERIODIC_HIST-1)
+			r = dprintf(fd, "%12llu %12s %12llu\n", 1ULL<<(i-1), "-", p->hist[i]);
+		else r = dprintf(fd, "%12llu %12llu %12llu\n", 1ULL<<(i-1), 1ULL<<i, p->hist[i]);
+	}
+	return r < 0 ? -1 : 0;
+}
@@ -0,0 +1,80 @@
+#include <time.h>
+#include <errno.h>
+#include <sys/prctl.h>
+#include <bibon/sleep.h>
+#include "syscall.h"
+#include "atomic.h"
+
+/* The margin tracks how late kernel wakeups arrive: it jumps up to
+ * a late wakeup plus a quarter, and decays slowly towards early
+ * ones, so it settles near the worst recent latency. Updates from
+ * concurrent sleepers may be lost, which is harmless. */
+
+#define MARGIN_MIN 2000
+#define MARGIN_MAX 2000000
+
+static volatile long margin = 50000;
+
+static long long now(clockid_t clk)
+{
+	struct timespec ts;
+	__clock_gettime(clk, &ts);
+	return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+int bibon_nanosleep_precise(clockid_t clk, int flags, const struct timespec *req, struct timespec *rem)
+{
+	long long t, end, wake, late;
+	long m = margin;
+	int r;
+
+	if (clk != CLOCK_REALTIME && clk != CLOCK_MONOTONIC && clk != CLOCK_BOOTTIME)
+		return __clock_nanosleep(clk, flags, req, rem);
+	if ((unsigned long)req->tv_nsec >= 1000000000) return EINVAL;
+
+	t = now(clk);
+	end = req->tv_sec * 1000000000LL + req->tv_nsec;
+	if (!(flags & TIMER_ABSTIME)) end += t;
+
+	wake = end - m;
+	if (wake > t) {
+		struct timespec ts = { wake / 1000000000, wake % 1000000000 };
+		r = __clock_nanosleep(clk, TIMER_ABSTIME, &ts, 0);
+		t = now(clk);
+		if (r) {
+			if (r == EINTR && rem && !(flags & TIMER_ABSTIME)) {
+				long long left = end > t ? end - t : 0;
+				rem->tv_sec = left / 1000000000;
+				rem->tv_nsec = left % 1000000000;
+			}
+			return r;
+		}
+		late = t - wake;
+		if (late > m) m = late + late/4;
+		else m -= (m - late) / 64;
+		if (m < MARGIN_MIN) m = MARGIN_MIN;
+		if (m > MARGIN_MAX) m = MARGIN_MAX;
+		margin = m;
+	}
+
+	while (t < end) {
+		a_spin();
+		t = now(clk);
+	}
+	return 0;
+}
+
+long bibon_sleep_margin(void)
+{
+	return margin;
+}
+
+int bibon_timerslack_set(unsigned long ns)
+{
+	return __syscall_ret(__syscall(SYS_prctl, PR_SET_TIMERSLACK, ns, 0, 0, 0));
+}
+
+long bibon_timerslack_get(void)
+{
+	return __syscall_ret(__syscall(SYS_prctl, PR_GET_TIMERSLACK, 0, 0, 0, 0));
+}
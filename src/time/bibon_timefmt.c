@@ -0,0 +1,85 @@
+#include <time.h>
+#include <string.h>
+#include <errno.h>
+#include <bibon/timefmt.h>
+
+int bibon_timefmt_init(struct bibon_timefmt *c, const char *fmt, int flags)
+{
+	const char *p, *q = 0;
+	int frac = 0;
+
+	for (p=fmt; *p; p++) {
+		if (*p != '%') continue;
+		if (p[1] == 'N' || (p[1]-'1' < 9U && p[2] == 'N')) {
+			if (q) return EINVAL;
+			q = p;
+			frac = p[1] == 'N' ? 9 : p[1]-'0';
+		} else if (p[1]) {
+			p++;
+		}
+	}
+	if (!q) q = p;
+	if (q-fmt >= (long)sizeof c->fmt[0]) return EINVAL;
+	p = q + (frac == 9 && q[1] == 'N' ? 2 : frac ? 3 : 0);
+	if (strlen(p) >= sizeof c->fmt[1]) return EINVAL;
+
+	memcpy(c->fmt[0], fmt, q-fmt);
+	c->fmt[0][q-fmt] = 0;
+	strcpy(c->fmt[1], p);
+	c->flags = flags;
+	c->frac = frac;
+	c->ok = 0;
+	return 0;
+}
+
+static size_t part(char *s, size_t n, const char *f, const struct tm *tm)
+{
+	size_t l;
+	if (!*f) {
+		*s = 0;
+		return 0;
+	}
+	l = strftime(s, n, f, tm);
+	return l ? l : -1;
+}
+
+size_t bibon_timefmt(struct bibon_timefmt *c, char *s, size_t n, const struct timespec *ts)
+{
+	static const unsigned pow10[] = {
+		1000000000, 100000000, 10000000, 1000000, 100000,
+		10000, 1000, 100, 10, 1 };
+	struct timespec now;
+	struct tm tm;
+	size_t a, b;
+	unsigned v;
+	int i;
+
+	if (!ts) {
+		__clock_gettime(CLOCK_REALTIME, &now);
+		ts = &now;
+	}
+	if ((unsigned long)ts->tv_nsec >= 1000000000) return 0;
+
+	if (!c->ok || ts->tv_sec != c->sec) {
+		c->ok = 0;
+		if (!(c->flags & BIBON_TIMEFMT_UTC ? __gmtime_r(&ts->tv_sec, &tm)
+		      : __localtime_r(&ts->tv_sec, &tm)))
+			return 0;
+		a = part(c->buf, sizeof c->buf - c->frac, c->fmt[0], &tm);
+		if (a == -1) return 0;
+		b = part(c->buf + a + c->frac, sizeof c->buf - a - c->frac, c->fmt[1], &tm);
+		if (b == -1) return 0;
+		c->pre = a;
+		c->len = a + c->frac + b;
+		c->sec = ts->tv_sec;
+		c->ok = 1;
+	}
+
+	v = ts->tv_nsec / pow10[c->frac];
+	for (i=c->frac; i; i--, v/=10)
+		c->buf[c->pre+i-1] = '0' + v%10;
+
+	if (c->len >= n) return 0;
+	memcpy(s, c->buf, c->len+1);
+	return c->len;
+}
@@ -213,6 +213,63 @@ recu_strftime:
 	return *s;
 }
 
+static char *put2(char *s, int v)
+{
+	s[0] = '0' + v/10;
+	s[1] = '0' + v%10;
+	return s+2;
+}
+
+/* Formats made only of literal characters and the numeric date and
+ * time conversions %Y %m %d %H %M %S %F %T, such as "%F %T" and
+ * ISO 8601 timestamps, do not depend on the locale and are written
+ * directly. Anything else, or fields out of the ranges these
+ * conversions print at fixed width, is left to the general loop. */
+
+static size_t fast_strftime(char *restrict s, size_t n, const char *restrict f, const struct tm *restrict tm)
+{
+	char *p = s, *e = s + n;
+	int y;
+
+	if (n < 11 || tm->tm_year < -1900 || tm->tm_year > 8099
+	    || tm->tm_mon > 11U || tm->tm_mday > 31U || tm->tm_hour > 23U
+	    || tm->tm_min > 59U || tm->tm_sec > 60U)
+		return 0;
+	y = tm->tm_year + 1900;
+	for (; *f; f++) {
+		if (e-p < 11) return 0;
+		if (*f != '%') {
+			*p++ = *f;
+			continue;
+		}
+		switch (*++f) {
+		case 'F':
+			p = put2(put2(p, y/100), y%100);
+			*p++ = '-';
+			p = put2(p, tm->tm_mon+1);
+			*p++ = '-';
+			p = put2(p, tm->tm_mday);
+			break;
+		case 'T':
+			p = put2(p, tm->tm_hour);
+			*p++ = ':';
+			p = put2(p, tm->tm_min);
+			*p++ = ':';
+			p = put2(p, tm->tm_sec);
+			break;
+		case 'Y': p = put2(put2(p, y/100), y%100); break;
+		case 'm': p = put2(p, tm->tm_mon+1); break;
+		case 'd': p = put2(p, tm->tm_mday); break;
+		case 'H': p = put2(p, tm->tm_hour); break;
+		case 'M': p = put2(p, tm->tm_min); break;
+		case 'S': p = put2(p, tm->tm_sec); break;
+		default: return 0;
+		}
+	}
+	*p = 0;
+	return p-s;
+}
+
 size_t __strftime_l(char *restrict s, size_t n, const char *restrict f, const struct tm *restrict tm, locale_t loc)
 {
 	size_t l, k;
@@ -221,6 +278,7 @@ size_t __strftime_l(char *restrict s, size_t n, const char *restrict f, const st
 	const char *t;
 	int pad, plus;
 	unsigned long width;
+	if ((l = fast_strftime(s, n, f, tm))) return l;
 	for (l=0; l<n; f++) {
 		if (!*f) {
 			s[l] = 0;
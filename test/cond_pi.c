@@ -0,0 +1,156 @@
+/*
+ * cond_pi.c
+ *
+ * Tests for condition variables waited on with priority-inheritance
+ * mutexes, which use the kernel's requeue-PI operations.
+ *
+ * Build:
+ *   musl-gcc -O2 -static cond_pi.c -o cond_pi_tests
+ */
+
+#define _GNU_SOURCE
+#include <assert.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <time.h>
+
+#define NWAITERS 8
+
+static pthread_mutex_t m;
+static pthread_cond_t c;
+static int go, waiting, woken;
+
+static void init_pi_mutex(pthread_mutex_t *mp) {
+    pthread_mutexattr_t a;
+    pthread_mutexattr_init(&a);
+    assert(!pthread_mutexattr_setprotocol(&a, PTHREAD_PRIO_INHERIT));
+    assert(!pthread_mutex_init(mp, &a));
+    pthread_mutexattr_destroy(&a);
+}
+
+static void init_cond(clockid_t clk) {
+    pthread_condattr_t a;
+    pthread_condattr_init(&a);
+    assert(!pthread_condattr_setclock(&a, clk));
+    assert(!pthread_cond_init(&c, &a));
+    pthread_condattr_destroy(&a);
+}
+
+static long long now_ns(clockid_t clk) {
+    struct timespec ts;
+    clock_gettime(clk, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static struct timespec deadline(clockid_t clk, long long ns) {
+    long long t = now_ns(clk) + ns;
+    return (struct timespec){ t / 1000000000, t % 1000000000 };
+}
+
+static void *waiter(void *arg) {
+    assert(!pthread_mutex_lock(&m));
+    waiting++;
+    while (go <= woken) assert(!pthread_cond_wait(&c, &m));
+    woken++;
+    assert(!pthread_mutex_unlock(&m));
+    return 0;
+}
+
+static void start_waiters(pthread_t *t, int n) {
+    go = woken = waiting = 0;
+    for (int i = 0; i < n; i++) assert(!pthread_create(&t[i], 0, waiter, 0));
+    for (;;) {
+        assert(!pthread_mutex_lock(&m));
+        int w = waiting;
+        assert(!pthread_mutex_unlock(&m));
+        if (w == n) break;
+        sched_yield();
+    }
+}
+
+/* Every waiter returns, holding the mutex, after one broadcast. */
+static void test_broadcast(void) {
+    pthread_t t[NWAITERS];
+    start_waiters(t, NWAITERS);
+    assert(!pthread_mutex_lock(&m));
+    go = NWAITERS;
+    assert(!pthread_cond_broadcast(&c));
+    assert(!pthread_mutex_unlock(&m));
+    for (int i = 0; i < NWAITERS; i++) assert(!pthread_join(t[i], 0));
+    assert(woken == NWAITERS);
+}
+
+/* Each signal releases a waiter; repeated signals release them all. */
+static void test_signal(void) {
+    pthread_t t[NWAITERS];
+    start_waiters(t, NWAITERS);
+    for (int i = 1; i <= NWAITERS; i++) {
+        assert(!pthread_mutex_lock(&m));
+        go = i;
+        assert(!pthread_cond_signal(&c));
+        assert(!pthread_mutex_unlock(&m));
+        for (;;) {
+            assert(!pthread_mutex_lock(&m));
+            int w = woken;
+            assert(!pthread_mutex_unlock(&m));
+            if (w == i) break;
+            sched_yield();
+        }
+    }
+    for (int i = 0; i < NWAITERS; i++) assert(!pthread_join(t[i], 0));
+}
+
+/* A timed wait with no signal times out near its deadline, on the
+ * cv's clock, and returns with the mutex held. */
+static void test_timeout(clockid_t clk) {
+    pthread_cond_destroy(&c);
+    init_cond(clk);
+    long long t0 = now_ns(CLOCK_MONOTONIC);
+    struct timespec ts = deadline(clk, 20000000);
+    assert(!pthread_mutex_lock(&m));
+    assert(pthread_cond_timedwait(&c, &m, &ts) == ETIMEDOUT);
+    assert(pthread_mutex_trylock(&m) == EBUSY);
+    assert(!pthread_mutex_unlock(&m));
+    long long dt = now_ns(CLOCK_MONOTONIC) - t0;
+    assert(dt >= 15000000 && dt < 2000000000);
+}
+
+/* A cv last waited on with a PI mutex still wakes waiters that use
+ * an ordinary mutex afterwards. */
+static void test_reuse_plain(void) {
+    pthread_t t[2];
+    struct timespec ts = deadline(CLOCK_MONOTONIC, 1000000);
+    pthread_cond_destroy(&c);
+    init_cond(CLOCK_MONOTONIC);
+    assert(!pthread_mutex_lock(&m));
+    assert(pthread_cond_timedwait(&c, &m, &ts) == ETIMEDOUT);
+    assert(!pthread_mutex_unlock(&m));
+
+    pthread_mutex_destroy(&m);
+    assert(!pthread_mutex_init(&m, 0));
+    start_waiters(t, 2);
+    for (int i = 1; i <= 2; i++) {
+        assert(!pthread_mutex_lock(&m));
+        go = i;
+        assert(!pthread_cond_signal(&c));
+        assert(!pthread_mutex_unlock(&m));
+    }
+    for (int i = 0; i < 2; i++) assert(!pthread_join(t[i], 0));
+}
+
+int main(void) {
+    init_pi_mutex(&m);
+    init_cond(CLOCK_REALTIME);
+
+    test_broadcast();
+    test_signal();
+    test_timeout(CLOCK_REALTIME);
+    test_timeout(CLOCK_MONOTONIC);
+    test_timeout(CLOCK_BOOTTIME);
+    test_reuse_plain();
+
+    pthread_mutex_destroy(&m);
+    puts("OK");
+    return 0;
+}
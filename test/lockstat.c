@@ -0,0 +1,102 @@
+/*
+ * lockstat.c
+ *
+ * Tests for the opt-in lock contention statistics.
+ *
+ * Build:
+ *   musl-gcc -O2 -static lockstat.c -o lockstat_tests
+ */
+
+#define _GNU_SOURCE
+#include <assert.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <time.h>
+#include <bibon/lockstat.h>
+
+static struct bibon_lockstat *find(const void *lock) {
+    static struct bibon_lockstat buf[64];
+    size_t n = bibon_lockstat_top(buf, 64);
+    for (size_t i = 0; i < n; i++)
+        if (buf[i].lock == lock) return &buf[i];
+    return 0;
+}
+
+static void sleep_ms(int ms) {
+    struct timespec ts = { 0, ms * 1000000L };
+    nanosleep(&ts, 0);
+}
+
+static pthread_mutex_t m = PTHREAD_MUTEX_INITIALIZER;
+
+static void *hold_mutex(void *arg) {
+    pthread_mutex_lock(&m);
+    sleep_ms(50);
+    pthread_mutex_unlock(&m);
+    return 0;
+}
+
+/* Failed trylocks and timeouts are not acquisitions. */
+static void test_mutex(void) {
+    pthread_t t;
+    struct timespec ts;
+    struct bibon_lockstat *s;
+
+    assert(!pthread_mutex_trylock(&m));
+    assert(!pthread_mutex_unlock(&m));
+    assert(!pthread_create(&t, 0, hold_mutex, 0));
+    sleep_ms(10);
+    assert(pthread_mutex_trylock(&m) == EBUSY);
+    clock_gettime(CLOCK_REALTIME, &ts);
+    ts.tv_nsec += 5000000;
+    if (ts.tv_nsec >= 1000000000) ts.tv_sec++, ts.tv_nsec -= 1000000000;
+    assert(pthread_mutex_timedlock(&m, &ts) == ETIMEDOUT);
+    assert(!pthread_mutex_lock(&m));
+    assert(!pthread_mutex_unlock(&m));
+    assert(!pthread_join(t, 0));
+
+    assert((s = find(&m)));
+    assert(s->kind == BIBON_LOCKSTAT_MUTEX);
+    assert(s->acquired == 3);
+    assert(s->contended == 1);
+    assert(s->busy == 1);
+    assert(s->timedout == 1);
+}
+
+static FILE *f;
+
+static void *hold_file(void *arg) {
+    flockfile(f);
+    sleep_ms(50);
+    funlockfile(f);
+    return 0;
+}
+
+/* A stdio call that waits for a FILE held with flockfile. */
+static void test_file(void) {
+    pthread_t t;
+    struct bibon_lockstat *s;
+
+    assert((f = fopen("/dev/null", "w")));
+    assert(!pthread_create(&t, 0, hold_file, 0));
+    sleep_ms(10);
+    assert(fputs("x", f) >= 0);
+    assert(!pthread_join(t, 0));
+
+    assert((s = find(f)));
+    assert(s->kind == BIBON_LOCKSTAT_FILE);
+    assert(s->acquired == 2);
+    assert(s->contended == 1);
+    assert(s->wait_ns > 10000000);
+    fclose(f);
+}
+
+int main(void) {
+    assert(!bibon_lockstat_enable(1));
+    test_mutex();
+    test_file();
+    bibon_lockstat_enable(0);
+    puts("OK");
+    return 0;
+}
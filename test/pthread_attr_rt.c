@@ -0,0 +1,173 @@
+/*
+ * pthread_attr_rt.c
+ *
+ * Tests for the affinity, deadline, prefault and mlock thread
+ * attributes. Deadline scheduling and memory locking need privileges;
+ * where the kernel refuses them, only consistency is checked.
+ *
+ * Build:
+ *   musl-gcc -O2 -static pthread_attr_rt.c -o pthread_attr_rt_tests
+ */
+
+#define _GNU_SOURCE
+#include <assert.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+
+static void *get_affinity(void *arg) {
+    cpu_set_t *set = arg;
+    assert(!sched_getaffinity(0, sizeof *set, set));
+    return 0;
+}
+
+static void *nop(void *arg) {
+    return arg;
+}
+
+/* Locked memory of the process in kB, as reported by /proc, read while a
+ * thread with a locked stack is running. */
+static long vmlck_kb(void) {
+    char line[128];
+    long kb = -1;
+    FILE *f = fopen("/proc/self/status", "r");
+    if (!f) return -1;
+    while (fgets(line, sizeof line, f))
+        if (sscanf(line, "VmLck: %ld kB", &kb) == 1) break;
+    fclose(f);
+    return kb;
+}
+
+static volatile long locked_kb;
+
+static void *read_vmlck(void *arg) {
+    locked_kb = vmlck_kb();
+    return 0;
+}
+
+static int create_join(pthread_attr_t *a, void *(*f)(void *), void *arg) {
+    pthread_t t;
+    void *r;
+    int e = pthread_create(&t, a, f, arg);
+    if (!e) {
+        assert(!pthread_join(t, &r));
+        assert(r == arg);
+    }
+    return e;
+}
+
+/* Each setter is read back by its getter, and clearing works. */
+static void test_get_set(void) {
+    pthread_attr_t a;
+    cpu_set_t set, got;
+    unsigned long long rt, dl, per;
+    int on;
+
+    pthread_attr_init(&a);
+    CPU_ZERO(&set);
+    CPU_SET(0, &set);
+    assert(!pthread_attr_setaffinity_np(&a, sizeof set, &set));
+    assert(!pthread_attr_getaffinity_np(&a, sizeof got, &got));
+    assert(CPU_EQUAL(&set, &got));
+
+    assert(!pthread_attr_setdeadline_np(&a, 1000000, 0, 10000000));
+    assert(!pthread_attr_getdeadline_np(&a, &rt, &dl, &per));
+    assert(rt == 1000000 && dl == 10000000 && per == 10000000);
+    assert(pthread_attr_setdeadline_np(&a, 2000000, 1000000, 0) == EINVAL);
+    assert(!pthread_attr_setdeadline_np(&a, 0, 0, 0));
+    assert(!pthread_attr_getdeadline_np(&a, &rt, &dl, &per));
+    assert(!rt);
+
+    assert(!pthread_attr_setprefault_np(&a, 1));
+    assert(!pthread_attr_getprefault_np(&a, &on) && on);
+    assert(!pthread_attr_setmlock_np(&a, 1));
+    assert(!pthread_attr_getmlock_np(&a, &on) && on);
+    assert(!pthread_attr_setmlock_np(&a, 0));
+    assert(!pthread_attr_getmlock_np(&a, &on) && !on);
+
+    assert(!pthread_attr_setaffinity_np(&a, 0, 0));
+    assert(!pthread_attr_getaffinity_np(&a, sizeof got, &got));
+    pthread_attr_destroy(&a);
+}
+
+/* The new thread starts with the requested affinity, and a mask
+ * the kernel rejects fails creation without leaking a thread. */
+static void test_affinity(void) {
+    pthread_attr_t a;
+    cpu_set_t set, got;
+    pthread_t t;
+
+    pthread_attr_init(&a);
+    CPU_ZERO(&set);
+    CPU_SET(0, &set);
+    assert(!pthread_attr_setaffinity_np(&a, sizeof set, &set));
+    assert(!pthread_create(&t, &a, get_affinity, &got));
+    assert(!pthread_join(t, 0));
+    assert(CPU_EQUAL(&set, &got));
+
+    CPU_ZERO(&set);
+    CPU_SET(CPU_SETSIZE-1, &set);
+    assert(!pthread_attr_setaffinity_np(&a, sizeof set, &set));
+    for (int i = 0; i < 100; i++)
+        assert(pthread_create(&t, &a, nop, 0) == EINVAL);
+    pthread_attr_destroy(&a);
+    assert(!create_join(0, nop, (void *)1));
+}
+
+/* Prefaulted and locked stacks still run the thread; a locked one
+ * shows up in VmLck while the thread runs. */
+static void test_prefault_mlock(void) {
+    pthread_attr_t a;
+    int e;
+
+    pthread_attr_init(&a);
+    pthread_attr_setstacksize(&a, 1 << 20);
+    assert(!pthread_attr_setprefault_np(&a, 1));
+    assert(!create_join(&a, nop, (void *)2));
+
+    assert(!pthread_attr_setmlock_np(&a, 1));
+    e = create_join(&a, read_vmlck, 0);
+    assert(!e || e == EAGAIN || e == EPERM);
+    if (!e) assert(locked_kb >= 1024);
+    pthread_attr_destroy(&a);
+}
+
+/* An affinity mask covering every cpu the caller may use does not
+ * change the outcome of a deadline request; one leaving cpus out is
+ * refused up front. */
+static void test_deadline(void) {
+    pthread_attr_t a;
+    cpu_set_t all;
+    int plain, e;
+
+    pthread_attr_init(&a);
+    assert(!pthread_attr_setdeadline_np(&a, 1000000, 10000000, 10000000));
+    plain = create_join(&a, nop, 0);
+    assert(!plain || plain == EPERM || plain == EBUSY);
+
+    assert(!sched_getaffinity(0, sizeof all, &all));
+    assert(!pthread_attr_setaffinity_np(&a, sizeof all, &all));
+    e = create_join(&a, nop, 0);
+    assert(e == plain);
+
+    if (CPU_COUNT(&all) > 1) {
+        cpu_set_t one;
+        int cpu = 0;
+        while (!CPU_ISSET(cpu, &all)) cpu++;
+        CPU_ZERO(&one);
+        CPU_SET(cpu, &one);
+        assert(!pthread_attr_setaffinity_np(&a, sizeof one, &one));
+        assert(create_join(&a, nop, 0) == EPERM);
+    }
+    pthread_attr_destroy(&a);
+}
+
+int main(void) {
+    test_get_set();
+    test_affinity();
+    test_prefault_mlock();
+    test_deadline();
+    puts("OK");
+    return 0;
+}
@@ -0,0 +1,87 @@
+/*
+ * rseq.c
+ *
+ * Tests for the BIBON_RSEQ=0 opt-out from libc's rseq registration.
+ * Skips (and passes) on kernels without rseq.
+ *
+ * Build:
+ *   musl-gcc -O2 -static rseq.c -o rseq_tests
+ */
+
+#define _GNU_SOURCE
+#include <assert.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+#if defined(__x86_64__)
+#define SIG 0x53053053
+#elif defined(__aarch64__)
+#define SIG 0xd428bc00
+#endif
+
+struct area {
+    uint32_t cpu_id_start, cpu_id;
+    uint64_t rseq_cs;
+    uint32_t flags, pad[3];
+} __attribute__((aligned(32)));
+
+static __thread struct area own;
+
+/* Try to register an area of our own, as librseq would. */
+static int register_own(void) {
+    if (syscall(SYS_rseq, &own, sizeof own, 0, SIG)) return errno;
+    assert(own.cpu_id == (uint32_t)sched_getcpu());
+    return 0;
+}
+
+static void *thread_register(void *arg) {
+    return (void *)(long)register_own();
+}
+
+static int in_thread(void) {
+    pthread_t t;
+    void *r;
+    assert(!pthread_create(&t, 0, thread_register, 0));
+    assert(!pthread_join(t, &r));
+    return (long)r;
+}
+
+/* By default libc holds the registration, and the kernel refuses a
+ * second area with EINVAL. */
+static void test_default(void) {
+    assert(register_own() == EINVAL);
+    assert(in_thread() == EINVAL);
+    assert(sched_getcpu() >= 0);
+}
+
+/* With the opt-out, the main thread and new threads are free. */
+static void test_opt_out(void) {
+    assert(register_own() == 0);
+    assert(in_thread() == 0);
+    assert(sched_getcpu() >= 0);
+}
+
+int main(int argc, char **argv) {
+#ifdef SIG
+    if (syscall(SYS_rseq, 0, 0, 0, 0) == -1 && errno == ENOSYS) {
+        puts("SKIP");
+        return 0;
+    }
+    if (!getenv("BIBON_RSEQ")) {
+        test_default();
+        setenv("BIBON_RSEQ", "0", 1);
+        execv(argv[0], argv);
+        assert(0);
+    }
+    test_opt_out();
+#endif
+    puts("OK");
+    return 0;
+}
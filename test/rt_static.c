@@ -0,0 +1,64 @@
+/*
+ * rt_static.c
+ *
+ * Tests that the real-time startup profile is applied in a static
+ * program that only defines bibon_rt_config or sets BIBON_RT, without
+ * calling anything else from <bibon/rt.h>.
+ *
+ * Build:
+ *   musl-gcc -O2 -static rt_static.c -o rt_static_tests
+ */
+
+#define _GNU_SOURCE
+#include <assert.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <bibon/rt.h>
+
+const struct bibon_rt_config bibon_rt_config = {
+    .flags = BIBON_RT_PIN,
+    .cpu_first = 0,
+    .cpu_last = 0,
+};
+
+static long vmlck_kb(void) {
+    char line[128];
+    long kb = -1;
+    FILE *f = fopen("/proc/self/status", "r");
+    if (!f) return -1;
+    while (fgets(line, sizeof line, f))
+        if (sscanf(line, "VmLck: %ld kB", &kb) == 1) break;
+    fclose(f);
+    return kb;
+}
+
+/* The link-time configuration pins the process to cpu 0. */
+static void test_config(void) {
+    cpu_set_t set;
+    assert(!sched_getaffinity(0, sizeof set, &set));
+    assert(CPU_COUNT(&set) == 1 && CPU_ISSET(0, &set));
+}
+
+/* BIBON_RT=mlock, which replaces the configuration, locks memory.
+ * Without privileges the lock may be refused. */
+static void test_env(void) {
+    if (geteuid()) return;
+    assert(vmlck_kb() > 0);
+}
+
+int main(int argc, char **argv) {
+    const char *env = getenv("BIBON_RT");
+    if (!env) {
+        test_config();
+        assert(!setenv("BIBON_RT", "mlock", 1));
+        execv(argv[0], argv);
+        assert(0);
+    }
+    assert(!strcmp(env, "mlock"));
+    test_env();
+    puts("OK");
+    return 0;
+}
@@ -0,0 +1,110 @@
+/*
+ * rwlock.c
+ *
+ * Tests for the reader-indicator rwlock kind (PTHREAD_RWLOCK_SCALABLE_NP).
+ *
+ * Build:
+ *   musl-gcc -O2 -static rwlock.c -o rwlock_tests
+ */
+
+#define _GNU_SOURCE
+#include <assert.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <time.h>
+
+static pthread_rwlock_t rw;
+
+static void *try_read(void *arg) {
+    int r = pthread_rwlock_tryrdlock(&rw);
+    if (!r) pthread_rwlock_unlock(&rw);
+    return (void *)(long)r;
+}
+
+static void *try_write(void *arg) {
+    int r = pthread_rwlock_trywrlock(&rw);
+    if (!r) pthread_rwlock_unlock(&rw);
+    return (void *)(long)r;
+}
+
+static long in_thread(void *(*f)(void *)) {
+    pthread_t t;
+    void *r;
+    assert(!pthread_create(&t, 0, f, 0));
+    assert(!pthread_join(t, &r));
+    return (long)r;
+}
+
+/* A failed trywrlock by a thread holding a read lock must leave the
+ * lock read-held, not write-held. */
+static void test_rdlock_then_trywrlock(void) {
+    assert(!pthread_rwlock_rdlock(&rw));
+    assert(pthread_rwlock_trywrlock(&rw) == EBUSY);
+    assert(in_thread(try_read) == 0);
+    assert(in_thread(try_write) == EBUSY);
+    assert(!pthread_rwlock_unlock(&rw));
+    assert(in_thread(try_write) == 0);
+}
+
+/* The same with a timed write lock that times out. */
+static void test_rdlock_then_timedwrlock(void) {
+    struct timespec ts;
+    assert(!pthread_rwlock_rdlock(&rw));
+    clock_gettime(CLOCK_REALTIME, &ts);
+    ts.tv_nsec += 10000000;
+    if (ts.tv_nsec >= 1000000000) ts.tv_sec++, ts.tv_nsec -= 1000000000;
+    assert(pthread_rwlock_timedwrlock(&rw, &ts) == ETIMEDOUT);
+    assert(in_thread(try_read) == 0);
+    assert(!pthread_rwlock_unlock(&rw));
+    assert(in_thread(try_write) == 0);
+}
+
+static void *write_lock(void *arg) {
+    int r = pthread_rwlock_wrlock(&rw);
+    if (!r) pthread_rwlock_unlock(&rw);
+    return (void *)(long)r;
+}
+
+static void sleep_ms(int ms) {
+    struct timespec ts = { 0, ms * 1000000L };
+    nanosleep(&ts, 0);
+}
+
+/* A recursive read lock must be granted while a writer is waiting
+ * for the reader's indicator, or the two deadlock. */
+static void test_recursive_rdlock_writer_waiting(void) {
+    pthread_t t;
+    struct timespec ts;
+    void *r;
+
+    assert(!pthread_rwlock_rdlock(&rw));
+    assert(!pthread_create(&t, 0, write_lock, 0));
+    sleep_ms(50);
+
+    assert(!pthread_rwlock_rdlock(&rw));
+    assert(!pthread_rwlock_tryrdlock(&rw));
+    clock_gettime(CLOCK_REALTIME, &ts);
+    ts.tv_sec++;
+    assert(!pthread_rwlock_timedrdlock(&rw, &ts));
+    for (int i = 0; i < 4; i++) assert(!pthread_rwlock_unlock(&rw));
+
+    assert(!pthread_join(t, &r));
+    assert(r == 0);
+    assert(in_thread(try_write) == 0);
+}
+
+int main(void) {
+    pthread_rwlockattr_t a;
+    pthread_rwlockattr_init(&a);
+    assert(!pthread_rwlockattr_setkind_np(&a, PTHREAD_RWLOCK_SCALABLE_NP));
+    assert(!pthread_rwlock_init(&rw, &a));
+
+    test_rdlock_then_trywrlock();
+    test_rdlock_then_timedwrlock();
+    test_recursive_rdlock_writer_waiting();
+
+    pthread_rwlock_destroy(&rw);
+    puts("OK");
+    return 0;
+}
@@ -0,0 +1,458 @@
+/*
+ * string_simd.c
+ *
+ * Tests for the vectorized string, memory and wide-character routines.
+ * Each routine is run over a sweep of lengths and alignments with its
+ * arguments placed against inaccessible pages, so that reading past
+ * either end of an argument faults. The program re-executes itself
+ * with BIBON_CPU set to each of several feature masks to reach every
+ * dispatched variant. The masks only matter on x86_64; elsewhere, as
+ * for the aarch64 routines, cross-compile and run it under qemu-user.
+ *
+ * Build:
+ *   musl-gcc -O2 -static string_simd.c -o string_simd_tests
+ */
+
+#define _GNU_SOURCE
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <wchar.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+#define PAGE 4096
+#define AREA (32 * PAGE)
+#define MAXLEN 300
+
+static const char *const masks[] = {
+    "avx2", "ssse3", "erms", "avx2,erms", "baseline",
+};
+
+static unsigned char *area_a, *area_b;
+static unsigned rng = 1;
+
+static unsigned rnd(void) {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+/* Returns n accessible bytes with an inaccessible page on each side. */
+static unsigned char *guarded(size_t n) {
+    unsigned char *p = mmap(0, n + 2 * PAGE, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    assert(p != MAP_FAILED);
+    assert(!mprotect(p, PAGE, PROT_NONE));
+    assert(!mprotect(p + PAGE + n, PAGE, PROT_NONE));
+    return p + PAGE;
+}
+
+/* A place for n bytes either ending at the guard page after the area
+ * or starting at the given offset from the one before it. */
+static unsigned char *place(unsigned char *area, size_t n, int tail, size_t align) {
+    return tail ? area + AREA - n : area + align;
+}
+
+static int sign(int x) {
+    return (x > 0) - (x < 0);
+}
+
+/* Nonzero bytes other than the search byte X, including ones with the
+ * high bit set. */
+#define X 0xe9
+
+static void fill(unsigned char *p, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        do p[i] = rnd(); while (!p[i] || p[i] == X);
+    }
+}
+
+/* Scanners for a byte or the terminator, with the byte absent, first,
+ * in the middle, and last. */
+static void test_scan(void) {
+    for (size_t n = 0; n <= MAXLEN; n++)
+    for (int tail = 0; tail < 2; tail++) {
+        unsigned char *p = place(area_a, n + 1, tail, n % 64);
+        char *s = (char *)p;
+        size_t ks[] = { n, 0, n / 2, n ? n - 1 : 0 };
+        for (int j = 0; j < 4; j++) {
+            size_t k = ks[j];
+            fill(p, n);
+            p[n] = 0;
+            if (k < n) p[k] = X;
+            char *first = k < n ? s + k : 0;
+
+            assert(strlen(s) == n);
+            assert(strnlen(s, n + 1) == n);
+            assert(strnlen(s, n / 2) == n / 2);
+            assert(memchr(s, X, n) == first);
+            assert(memchr(s, X, k) == 0);
+            assert(memchr(s, 0, n + 1) == s + n);
+            assert(memrchr(s, X, n) == first);
+            assert(strchr(s, X) == first);
+            assert(strchr(s, 0) == s + n);
+            assert(strchrnul(s, X) == (first ? first : s + n));
+            assert(strrchr(s, X) == first);
+            assert(strrchr(s, 0) == s + n);
+
+            if (k + 1 < n) {
+                p[n - 1] = X;
+                assert(strchr(s, X) == first);
+                assert(memchr(s, X, n) == first);
+                assert(strrchr(s, X) == s + n - 1);
+                assert(memrchr(s, X, n) == s + n - 1);
+            }
+        }
+    }
+}
+
+/* Byte and string comparisons with the difference at the start, in
+ * the middle and at the end, in both directions, and against a
+ * shorter string. */
+static void test_compare(void) {
+    for (size_t n = 1; n <= MAXLEN; n++)
+    for (int tail = 0; tail < 2; tail++) {
+        unsigned char *a = place(area_a, n + 1, tail, n % 61);
+        unsigned char *b = place(area_b, n + 1, !tail, n % 53);
+        char *sa = (char *)a, *sb = (char *)b;
+        size_t ks[] = { 0, n / 2, n - 1 };
+
+        fill(a, n);
+        a[n] = 0;
+        memcpy(b, a, n + 1);
+        assert(!memcmp(a, b, n));
+        assert(!strcmp(sa, sb));
+        assert(!strncmp(sa, sb, n + 5));
+        for (int j = 0; j < 3; j++) {
+            size_t k = ks[j];
+            unsigned char c = b[k];
+            do b[k] = rnd(); while (!b[k] || b[k] == a[k]);
+            int want = sign(a[k] - b[k]);
+            assert(sign(memcmp(a, b, n)) == want);
+            assert(sign(memcmp(b, a, n)) == -want);
+            assert(!memcmp(a, b, k));
+            assert(sign(strcmp(sa, sb)) == want);
+            assert(sign(strcmp(sb, sa)) == -want);
+            assert(sign(strncmp(sa, sb, n)) == want);
+            assert(!strncmp(sa, sb, k));
+            b[k] = 0;
+            assert(strcmp(sa, sb) > 0);
+            assert(strncmp(sb, sa, n) < 0);
+            b[k] = c;
+        }
+    }
+}
+
+static int lower(int c) {
+    return c >= 'A' && c <= 'Z' ? c | 32 : c;
+}
+
+/* Case-insensitive comparisons of letters against the same letters
+ * in the other case, with one letter changed. */
+static void test_case(void) {
+    static const char alpha[] = "abcdefghijklmnopqrstuvwxyz"
+                                "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789@[`{";
+    for (size_t n = 1; n <= MAXLEN; n++)
+    for (int tail = 0; tail < 2; tail++) {
+        char *a = (char *)place(area_a, n + 1, tail, n % 61);
+        char *b = (char *)place(area_b, n + 1, !tail, n % 53);
+        size_t ks[] = { 0, n / 2, n - 1 };
+
+        for (size_t i = 0; i < n; i++) {
+            a[i] = alpha[rnd() % (sizeof alpha - 1)];
+            b[i] = (a[i] | 32) >= 'a' && (a[i] | 32) <= 'z' ? a[i] ^ 32 : a[i];
+        }
+        a[n] = b[n] = 0;
+        assert(!strcasecmp(a, b));
+        assert(!strncasecmp(a, b, n + 5));
+        for (int j = 0; j < 3; j++) {
+            size_t k = ks[j];
+            char c = b[k];
+            int la = lower(a[k]);
+            b[k] = la == 'a' ? 'Z' : 'A';
+            int want = sign(la - lower(b[k]));
+            assert(sign(strcasecmp(a, b)) == want);
+            assert(sign(strncasecmp(b, a, n)) == -want);
+            assert(!strncasecmp(a, b, k));
+            b[k] = c;
+        }
+    }
+}
+
+static void check_copy(const unsigned char *d, const unsigned char *s, size_t n) {
+    for (size_t i = 0; i < n; i++) assert(d[i] == s[i]);
+}
+
+/* The rest of area_b, filled with X beforehand, is untouched. */
+static void check_around(const unsigned char *d, size_t n) {
+    for (const unsigned char *q = area_b; q < d; q++) assert(*q == X);
+    for (const unsigned char *q = d + n; q < area_b + AREA; q++) assert(*q == X);
+}
+
+/* Copies and fills of every size up to MAXLEN and around the sizes
+ * at which the implementation changes strategy, without touching the
+ * bytes on either side. */
+static void test_copy(void) {
+    static unsigned char ref[AREA];
+    size_t sizes[MAXLEN + 16], nsizes = 0;
+    size_t extra[] = { 511, 1024, 2047, 2048, 2049, 4095, 4096, 4097,
+                       8191, 16411, 65543, AREA - 128 };
+
+    for (size_t n = 0; n <= MAXLEN; n++) sizes[nsizes++] = n;
+    for (size_t i = 0; i < sizeof extra / sizeof *extra; i++)
+        sizes[nsizes++] = extra[i];
+
+    for (size_t i = 0; i < nsizes; i++)
+    for (int tail = 0; tail < 2; tail++) {
+        size_t n = sizes[i];
+        unsigned char *s = place(area_a, n, tail, i % 64);
+        unsigned char *d = place(area_b, n, !tail, (i * 7) % 64);
+
+        fill(s, n);
+        memset(area_b, X, AREA);
+        assert(memcpy(d, s, n) == d);
+        check_copy(d, s, n);
+        check_around(d, n);
+
+        memset(area_b, X, AREA);
+        assert(memset(d, 0x5a, n) == d);
+        for (size_t j = 0; j < n; j++) assert(d[j] == 0x5a);
+        check_around(d, n);
+    }
+
+    /* Overlapping moves in both directions, by small and large
+     * distances, checked against a copy made through a temporary. */
+    for (size_t i = 0; i < nsizes; i++) {
+        size_t n = sizes[i];
+        size_t dists[] = { 1, 3, 16, 33, 64, 255, 4097 };
+        for (size_t j = 0; j < sizeof dists / sizeof *dists; j++) {
+            size_t dist = dists[j];
+            if (n + dist > AREA) continue;
+            unsigned char *lo = area_a + AREA - n - dist, *hi = lo + dist;
+
+            fill(area_a + AREA - n - dist, n + dist);
+            memcpy(ref, lo, n);
+            assert(memmove(hi, lo, n) == hi);
+            check_copy(hi, ref, n);
+
+            fill(area_a + AREA - n - dist, n + dist);
+            memcpy(ref, hi, n);
+            assert(memmove(lo, hi, n) == lo);
+            check_copy(lo, ref, n);
+        }
+    }
+}
+
+/* String copies, which must not read past the terminator. */
+static void test_strcpy(void) {
+    for (size_t n = 0; n <= MAXLEN; n++)
+    for (int tail = 0; tail < 2; tail++) {
+        unsigned char *s = place(area_a, n + 1, tail, n % 64);
+        unsigned char *d = place(area_b, n + 1, !tail, n % 37);
+
+        fill(s, n);
+        s[n] = 0;
+        memset(area_b, X, AREA);
+        assert(stpcpy((char *)d, (char *)s) == (char *)d + n);
+        check_copy(d, s, n + 1);
+        check_around(d, n + 1);
+        memset(area_b, X, AREA);
+        assert(strcpy((char *)d, (char *)s) == (char *)d);
+        check_copy(d, s, n + 1);
+        check_around(d, n + 1);
+    }
+}
+
+/* Copies, moves and fills larger than any cache, which use streaming
+ * stores. */
+static void test_copy_large(void) {
+    size_t n = 48 << 20;
+    unsigned char *a = guarded(n + PAGE), *b = guarded(n + PAGE);
+
+    for (size_t i = 0; i < n + PAGE; i++) a[i] = i * 7 + (i >> 12);
+    assert(memcpy(b + 3, a + 1, n) == b + 3);
+    check_copy(b + 3, a + 1, n);
+    assert(memmove(b + 1, b + 3, n) == b + 1);
+    check_copy(b + 1, a + 1, n);
+    assert(memmove(b + 5, b + 1, n) == b + 5);
+    check_copy(b + 5, a + 1, n);
+    assert(memset(b + 7, 0, n) == b + 7);
+    for (size_t i = 0; i < n; i++) assert(!b[7 + i]);
+    munmap(a - PAGE, n + 3 * PAGE);
+    munmap(b - PAGE, n + 3 * PAGE);
+}
+
+static const unsigned char *naive_search(const unsigned char *h, size_t hl,
+                                         const unsigned char *n, size_t nl, int fold) {
+    for (size_t i = 0; i + nl <= hl; i++) {
+        size_t j = 0;
+        while (j < nl && (fold ? (h[i + j] | 32) == (n[j] | 32) : h[i + j] == n[j])) j++;
+        if (j == nl) return h + i;
+    }
+    return 0;
+}
+
+/* Substring searches over a two-letter alphabet, where candidates are
+ * frequent, with needles cut from the haystack and made up; then a
+ * case whose verification cost forces the fallback to Two-Way. */
+static void test_search(void) {
+    for (size_t n = 0; n <= MAXLEN; n++)
+    for (int tail = 0; tail < 2; tail++) {
+        unsigned char *h = place(area_a, n + 1, tail, n % 64);
+        for (size_t i = 0; i < n; i++) h[i] = "ab"[rnd() % 5 == 0];
+        h[n] = 0;
+        for (size_t nl = 1; nl <= 20; nl++) {
+            unsigned char *nd = place(area_b, nl + 1, 1, 0);
+            if (nl <= n && rnd() % 2) memcpy(nd, h + rnd() % (n - nl + 1), nl);
+            else for (size_t i = 0; i < nl; i++) nd[i] = "ab"[rnd() % 3 == 0];
+            nd[nl] = 0;
+
+            const unsigned char *want = naive_search(h, n, nd, nl, 0);
+            assert(strstr((char *)h, (char *)nd) == (char *)want);
+            assert(memmem(h, n, nd, nl) == want);
+            nd[rnd() % nl] ^= 32;
+            want = naive_search(h, n, nd, nl, 1);
+            assert(strcasestr((char *)h, (char *)nd) == (char *)want);
+        }
+    }
+
+    size_t hl = AREA - 1, nl = 1000;
+    unsigned char *h = area_a, *nd = place(area_b, nl + 1, 1, 0);
+    memset(h, 'a', hl);
+    h[hl] = 0;
+    memset(nd, 'a', nl);
+    nd[nl - 1] = 'b';
+    nd[nl] = 0;
+    assert(!strstr((char *)h, (char *)nd));
+    assert(!memmem(h, hl, nd, nl));
+    h[hl - 1] = 'b';
+    assert(strstr((char *)h, (char *)nd) == (char *)h + hl - nl);
+    assert(memmem(h, hl, nd, nl) == h + hl - nl);
+}
+
+/* Span functions with accept and reject sets of every size up to
+ * several bytes, and one large enough to need a table. */
+static void test_span(void) {
+    for (size_t n = 0; n <= MAXLEN; n++)
+    for (int tail = 0; tail < 2; tail++)
+    for (size_t cl = 1; cl <= 24; cl += cl < 6 ? 1 : 9) {
+        unsigned char *s = place(area_a, n + 1, tail, n % 64);
+        unsigned char *c = place(area_b, cl + 1, 1, 0);
+        unsigned char in[256] = { 0 };
+
+        for (size_t i = 0; i < cl; i++) {
+            do c[i] = rnd(); while (!c[i]);
+            in[c[i]] = 1;
+        }
+        c[cl] = 0;
+        /* Mostly bytes from the set, so that spans get long. */
+        for (size_t i = 0; i < n; i++) {
+            if (rnd() % 32) s[i] = c[rnd() % cl];
+            else do s[i] = rnd(); while (!s[i]);
+        }
+        s[n] = 0;
+
+        size_t acc = 0, rej = 0;
+        while (acc < n && in[s[acc]]) acc++;
+        while (rej < n && !in[s[rej]]) rej++;
+        assert(strspn((char *)s, (char *)c) == acc);
+        assert(strcspn((char *)s, (char *)c) == rej);
+        assert(strpbrk((char *)s, (char *)c) == (rej < n ? (char *)s + rej : 0));
+
+        for (size_t i = 0; i < n; i++) if (!in[s[i]]) s[i] = c[0];
+        assert(strspn((char *)s, (char *)c) == n);
+        assert(strcspn((char *)s, "") == n);
+    }
+}
+
+static wchar_t wrnd(void) {
+    static const wchar_t edge[] = { 1, 0x7f, 0x80, 0xff, 0x100, 0xffff,
+                                    0x10000, 0x10ffff, 0x7fffffff };
+    wchar_t w;
+    do w = rnd() % 4 ? edge[rnd() % 9] : (wchar_t)(rnd() & 0x7fffffff);
+    while (!w || w == L'x');
+    return w;
+}
+
+/* The wide-character routines, over the same sweep in units of
+ * wchar_t. */
+static void test_wide(void) {
+    for (size_t n = 0; n <= MAXLEN; n++)
+    for (int tail = 0; tail < 2; tail++) {
+        size_t bytes = (n + 1) * sizeof(wchar_t);
+        wchar_t *s = (wchar_t *)place(area_a, bytes, tail, n * 4 % 64);
+        wchar_t *t = (wchar_t *)place(area_b, bytes, !tail, n * 4 % 48);
+        size_t ks[] = { n, 0, n / 2, n ? n - 1 : 0 };
+
+        for (int j = 0; j < 4; j++) {
+            size_t k = ks[j];
+            for (size_t i = 0; i < n; i++) s[i] = wrnd();
+            s[n] = 0;
+            if (k < n) s[k] = L'x';
+            wchar_t *first = k < n ? s + k : 0;
+
+            assert(wcslen(s) == n);
+            assert(wcschr(s, L'x') == first);
+            assert(wcschr(s, 0) == s + n);
+            assert(wmemchr(s, L'x', n) == first);
+            assert(wmemchr(s, L'x', k) == 0);
+
+            assert(wmemset(t, L'y', n + 1) == t);
+            for (size_t i = 0; i <= n; i++) assert(t[i] == L'y');
+            for (size_t i = 0; i <= n; i++) t[i] = s[i];
+            assert(!wcscmp(s, t));
+            assert(!wmemcmp(s, t, n));
+            if (k < n) {
+                t[k] = s[k] + (rnd() % 2 ? 1 : -1);
+                int want = s[k] < t[k] ? -1 : 1;
+                assert(sign(wcscmp(s, t)) == want);
+                assert(sign(wmemcmp(t, s, n)) == -want);
+                assert(!wmemcmp(s, t, k));
+                t[k] = 0;
+                assert(wcscmp(s, t) > 0);
+            }
+        }
+    }
+}
+
+static void run(void) {
+    area_a = guarded(AREA);
+    area_b = guarded(AREA);
+    test_scan();
+    test_compare();
+    test_case();
+    test_copy();
+    test_strcpy();
+    test_copy_large();
+    test_search();
+    test_span();
+    test_wide();
+}
+
+int main(int argc, char **argv) {
+    run();
+    if (getenv("BIBON_CPU")) return 0;
+
+    for (size_t i = 0; i < sizeof masks / sizeof *masks; i++) {
+        int status;
+        pid_t pid = fork();
+        assert(pid >= 0);
+        if (!pid) {
+            setenv("BIBON_CPU", masks[i], 1);
+            execv(argv[0], argv);
+            _exit(127);
+        }
+        assert(waitpid(pid, &status, 0) == pid);
+        if (!WIFEXITED(status) || WEXITSTATUS(status)) {
+            printf("BIBON_CPU=%s failed\n", masks[i]);
+            return 1;
+        }
+    }
+    puts("OK");
+    return 0;
+}
@@ -0,0 +1,60 @@
+/*
+ * tzcache.c
+ *
+ * Tests for the cached zone interval used by localtime.
+ * Needs the America/New_York zoneinfo file.
+ *
+ * Build:
+ *   musl-gcc -O2 -static tzcache.c -o tzcache_tests
+ */
+
+#define _GNU_SOURCE
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Switching zones through tzset must drop the cached entry, whose
+ * zone name points into the zoneinfo mapping that gets unmapped. */
+static void test_tzset_switch(void) {
+    time_t t = 1700000000;
+    struct tm tm;
+
+    setenv("TZ", "America/New_York", 1);
+    assert(localtime_r(&t, &tm));
+    assert(!strcmp(tm.tm_zone, "EST"));
+
+    setenv("TZ", "UTC0", 1);
+    tzset();
+
+    setenv("TZ", "America/New_York", 1);
+    assert(localtime_r(&t, &tm));
+    assert(!strcmp(tm.tm_zone, "EST"));
+    assert(tm.tm_gmtoff == -5*3600);
+}
+
+/* The same for POSIX zones, whose names live in static buffers. */
+static void test_posix_switch(void) {
+    time_t t = 1700000000;
+    struct tm tm;
+
+    setenv("TZ", "AAA5", 1);
+    assert(localtime_r(&t, &tm));
+    assert(!strcmp(tm.tm_zone, "AAA"));
+
+    setenv("TZ", "BBB3", 1);
+    tzset();
+
+    setenv("TZ", "AAA5", 1);
+    assert(localtime_r(&t, &tm));
+    assert(!strcmp(tm.tm_zone, "AAA"));
+    assert(tm.tm_gmtoff == -5*3600);
+}
+
+int main(void) {
+    test_tzset_switch();
+    test_posix_switch();
+    puts("OK");
+    return 0;
+}